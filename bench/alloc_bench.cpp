@@ -0,0 +1,145 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../src/lexer.h"
+#include "../src/parser.h"
+#include "../src/compiler.h"
+#include "../src/vm.h"
+#include "../src/metrics.h"
+#include "../src/alloc_tracker.h"
+
+using namespace dacite;
+
+// Allocation budget benchmark
+//
+// Runs each pipeline stage on inputs of increasing size under an
+// AllocationScope and fails when a stage allocates more than its budget.
+// Allocation counts are deterministic, so this runs as a regular test.
+
+namespace {
+
+/// Allocation budget for one stage: a fixed setup cost plus a cost per unit of work
+struct Budget {
+    const char* stage;
+    const char* unit;
+    double per_unit;
+    uint64_t fixed;
+};
+
+constexpr Budget LEXER_BUDGET = {"lex", "token", 1.0, 16};
+constexpr Budget PARSER_BUDGET = {"parse", "token", 1.0, 16};
+constexpr Budget COMPILER_BUDGET = {"compile", "instruction", 0.25, 16};
+constexpr Budget VM_BUDGET = {"run", "instruction", 0.0, 8};
+
+// One function returning an arithmetic expression with `terms` literals
+std::string make_source(size_t terms) {
+    static constexpr const char* OPS[] = {" + ", " * ", " - ", " / "};
+    std::string source = "package bench;\n\nfn main() i32 {\n    return 1";
+    for (size_t i = 1; i < terms; ++i) {
+        source += OPS[i % 4];
+        source += std::to_string(i % 9 + 1);
+    }
+    source += ";\n}\n";
+    return source;
+}
+
+size_t failures = 0;
+
+void report(const std::string& input, const Budget& budget, const AllocationStats& stats, size_t units) {
+    double per_unit = static_cast<double>(stats.allocations) / static_cast<double>(units);
+    double allowed = static_cast<double>(budget.fixed) + budget.per_unit * static_cast<double>(units);
+    bool ok = static_cast<double>(stats.allocations) <= allowed;
+    if (!ok) failures++;
+
+    std::cout << "  " << std::left << std::setw(10) << input << std::setw(9) << budget.stage << std::right
+              << std::setw(8) << stats.allocations
+              << std::setw(12) << stats.bytes
+              << std::setw(12) << stats.peak_live_bytes
+              << std::setw(10) << std::setprecision(3) << per_unit << " / " << std::left << std::setw(12) << budget.unit
+              << (ok ? "ok" : "OVER BUDGET") << " (<= " << budget.fixed << " + " << std::setprecision(2)
+              << budget.per_unit << " per " << budget.unit << ")" << std::right << std::endl;
+}
+
+void run_input(const std::string& name, size_t terms) {
+    std::string source = make_source(terms);
+
+    TokenBuffer tokens;
+    {
+        AllocationScope scope;
+        Lexer lexer(source);
+        lexer.tokenize_all(tokens);
+        report(name, LEXER_BUDGET, scope.stats(), tokens.size());
+    }
+    size_t token_count = tokens.size();
+
+    std::unique_ptr<Program> program;
+    {
+        AllocationScope scope;
+        Parser parser(std::move(tokens));
+        program = parser.parse();
+        report(name, PARSER_BUDGET, scope.stats(), token_count);
+    }
+
+    Chunk chunk;
+    {
+        AllocationScope scope;
+        Compiler compiler;
+        if (compiler.compile(*program, chunk) != CompileResult::OK) {
+            std::cerr << "Benchmark program failed to compile: " << compiler.get_error_message() << std::endl;
+            std::exit(2);
+        }
+        // Every instruction is an opcode plus at most one operand byte
+        report(name, COMPILER_BUDGET, scope.stats(), chunk.get_code().size() / 2 + 1);
+    }
+
+    {
+        // Instructions are only counted under a metrics sink, which stays out of the measured run
+        Metrics metrics;
+        VMConfig counting_config;
+        counting_config.metrics = &metrics;
+        VM counting_vm(counting_config);
+        if (counting_vm.run(chunk) != VMResult::OK) {
+            std::cerr << "Benchmark program failed to run: " << counting_vm.get_error_message() << std::endl;
+            std::exit(2);
+        }
+        
+        VM vm;
+        AllocationScope scope;
+        if (vm.run(chunk) != VMResult::OK) {
+            std::cerr << "Benchmark program failed to run: " << vm.get_error_message() << std::endl;
+            std::exit(2);
+        }
+        report(name, VM_BUDGET, scope.stats(), counting_vm.get_instructions_executed());
+    }
+}
+
+} // namespace
+
+int main() {
+    if (!alloc_tracker::is_enabled()) {
+        std::cerr << "Allocation hook is not linked into this executable" << std::endl;
+        return 2;
+    }
+
+    std::cout << "Running Allocation Benchmarks..." << std::endl;
+    std::cout << std::fixed;
+    std::cout << "  " << std::left << std::setw(10) << "input" << std::setw(9) << "stage" << std::right
+              << std::setw(8) << "allocs" << std::setw(12) << "bytes" << std::setw(12) << "peak live"
+              << std::setw(10) << "allocs" << " / unit" << std::endl;
+
+    // Constants are capped at 256 per chunk
+    run_input("tiny", 1);
+    run_input("small", 16);
+    run_input("medium", 64);
+    run_input("large", 250);
+
+    if (failures > 0) {
+        std::cout << "FAILED: " << failures << " stage(s) over their allocation budget" << std::endl;
+        return 1;
+    }
+    std::cout << "All stages within their allocation budgets" << std::endl;
+    return 0;
+}
\ No newline at end of file
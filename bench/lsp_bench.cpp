@@ -0,0 +1,117 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../src/json.h"
+#include "../src/language_server.h"
+
+using namespace dacite;
+
+// Simple benchmark harness
+using Clock = std::chrono::steady_clock;
+
+constexpr double RESPONSE_BUDGET_MS = 50.0;
+
+// Generate one workspace file with `lines` single-line functions
+std::string make_file(size_t file, size_t lines) {
+    std::string text = "package main;\n";
+    for (size_t line = 1; line < lines; ++line) {
+        text += "fn f" + std::to_string(file) + "_" + std::to_string(line) +
+                "() i32 { return " + std::to_string(line) + " + 1 * 2; }\n";
+    }
+    return text;
+}
+
+std::string did_open(const std::string& uri, const std::string& text) {
+    return Json(Json::Object{
+        {"jsonrpc", "2.0"},
+        {"method", "textDocument/didOpen"},
+        {"params", Json::Object{{"textDocument", Json::Object{{"uri", uri}, {"version", 1}, {"text", text}}}}},
+    }).dump();
+}
+
+std::string did_change(const std::string& uri, int version, const std::string& text) {
+    return Json(Json::Object{
+        {"jsonrpc", "2.0"},
+        {"method", "textDocument/didChange"},
+        {"params", Json::Object{
+            {"textDocument", Json::Object{{"uri", uri}, {"version", version}}},
+            {"contentChanges", Json::Array{Json::Object{{"text", text}}}}}},
+    }).dump();
+}
+
+std::string definition(int id, const std::string& uri, size_t line) {
+    return Json(Json::Object{
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"method", "textDocument/definition"},
+        {"params", Json::Object{
+            {"textDocument", Json::Object{{"uri", uri}}},
+            {"position", Json::Object{{"line", line}, {"character", 4}}}}},
+    }).dump();
+}
+
+// Time one server call in milliseconds
+double timed(LanguageServer& server, const std::string& message) {
+    auto start = Clock::now();
+    server.handle(message);
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const char* name, std::vector<double> times) {
+    std::sort(times.begin(), times.end());
+    std::cout << "  " << std::left << std::setw(12) << name << std::right
+              << " median " << std::setw(9) << times[times.size() / 2] << " ms"
+              << "   max " << std::setw(9) << times.back() << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t files = argc > 1 ? std::stoul(argv[1]) : 100;
+    size_t lines_per_file = argc > 2 ? std::stoul(argv[2]) : 1000;
+    size_t edits = argc > 3 ? std::stoul(argv[3]) : 200;
+
+    std::cout << "Running Language Server Benchmarks (" << files * lines_per_file
+              << " lines in " << files << " files)..." << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    LanguageServer server;
+    std::vector<std::string> texts;
+    std::vector<double> open_times;
+    for (size_t file = 0; file < files; ++file) {
+        texts.push_back(make_file(file, lines_per_file));
+        open_times.push_back(timed(server, did_open("file:///ws/f" + std::to_string(file) + ".dt", texts.back())));
+    }
+
+    // Replay an edit session: change one function per edit, then jump to a definition
+    std::vector<double> change_times;
+    std::vector<double> definition_times;
+    for (size_t edit = 0; edit < edits; ++edit) {
+        size_t file = (edit * 7) % files;
+        size_t line = 1 + (edit * 13) % (lines_per_file - 1);
+        std::string uri = "file:///ws/f" + std::to_string(file) + ".dt";
+
+        std::string& text = texts[file];
+        size_t pos = text.find(" + 1 * 2;", text.find("fn f" + std::to_string(file) + "_" + std::to_string(line) + "("));
+        text.replace(pos, 9, " - 3 * 4;");
+        change_times.push_back(timed(server, did_change(uri, static_cast<int>(edit) + 2, text)));
+        definition_times.push_back(timed(server, definition(static_cast<int>(edit), uri, line)));
+
+        text.replace(pos, 9, " + 1 * 2;");
+    }
+
+    report("didOpen", open_times);
+    report("didChange", change_times);
+    report("definition", definition_times);
+
+    double worst = std::max({*std::max_element(change_times.begin(), change_times.end()),
+                             *std::max_element(definition_times.begin(), definition_times.end())});
+    if (worst > RESPONSE_BUDGET_MS) {
+        std::cout << "FAILED: slowest response " << worst << " ms exceeds the "
+                  << RESPONSE_BUDGET_MS << " ms budget" << std::endl;
+        return 1;
+    }
+    std::cout << "All responses within the " << RESPONSE_BUDGET_MS << " ms budget" << std::endl;
+    return 0;
+}
\ No newline at end of file
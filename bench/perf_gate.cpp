@@ -0,0 +1,336 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/lexer.h"
+#include "../src/parser.h"
+#include "../src/compiler.h"
+#include "../src/vm.h"
+#include "../src/json.h"
+
+using namespace dacite;
+
+// Performance regression gate
+//
+// Runs the pipeline benchmarks, compares each one against the committed
+// baseline with a one-sided Mann-Whitney U test, and fails when a stage is
+// both significantly and materially slower than the baseline.
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/// Gate configuration
+struct GateConfig {
+    std::string baseline_path = "bench/baseline.json";
+    size_t samples = 15;         // Timed samples per benchmark
+    double sample_ms = 5.0;      // Target duration of one sample
+    double threshold = 0.10;     // Minimum median slowdown that counts as a regression
+    double alpha = 0.01;         // Significance level
+    bool update = false;         // Write the results as the new baseline
+};
+
+/// One benchmark in the suite
+struct Benchmark {
+    std::string name;
+    std::function<void()> run;   // One operation
+};
+
+/// Benchmark results: nanoseconds per operation, one entry per sample
+struct BenchResult {
+    std::string name;
+    std::vector<double> samples;
+};
+
+// Synthetic program: one function returning a long mixed arithmetic expression
+std::string make_source(size_t terms) {
+    static constexpr const char* OPS[] = {" + ", " * ", " - ", " / "};
+    std::string source = "package bench;\n\nfn main() i32 {\n    return 1";
+    for (size_t i = 1; i < terms; ++i) {
+        source += OPS[i % 4];
+        source += std::to_string(i % 9 + 1);
+        if (i % 16 == 0) source += "\n        ";
+    }
+    source += ";\n}\n";
+    return source;
+}
+
+std::vector<Benchmark> make_suite() {
+    // Constants are capped at 256 per chunk
+    static const std::string source = make_source(250);
+    static const TokenBuffer tokens = [] {
+        TokenBuffer tokens;
+        Lexer(source).tokenize_all(tokens);
+        return tokens;
+    }();
+    static const std::unique_ptr<Program> program = Parser(tokens).parse();
+    static const Chunk chunk = [] {
+        Chunk chunk;
+        Compiler compiler;
+        if (compiler.compile(*program, chunk) != CompileResult::OK) {
+            std::cerr << "Benchmark program failed to compile: " << compiler.get_error_message() << std::endl;
+            std::exit(2);
+        }
+        return chunk;
+    }();
+
+    return {
+        {"lexer", [] {
+            Lexer lexer(source);
+            TokenBuffer result;
+            lexer.tokenize_all(result);
+            if (result.empty()) std::abort();
+        }},
+        {"parser", [] {
+            Parser parser(tokens);
+            auto result = parser.parse();
+            if (!result) std::abort();
+        }},
+        {"compiler", [] {
+            Compiler compiler;
+            Chunk output;
+            if (compiler.compile(*program, output) != CompileResult::OK) std::abort();
+        }},
+        {"vm_run", [] {
+            VM vm;
+            if (vm.run(chunk) != VMResult::OK) std::abort();
+        }},
+    };
+}
+
+BenchResult measure(const Benchmark& benchmark, const GateConfig& config) {
+    // Calibrate the batch size so one sample takes roughly sample_ms
+    size_t batch = 1;
+    while (true) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; ++i) benchmark.run();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (ms >= config.sample_ms || batch >= (size_t{1} << 24)) break;
+        batch *= 2;
+    }
+
+    BenchResult result{benchmark.name, {}};
+    for (size_t s = 0; s < config.samples; ++s) {
+        auto start = Clock::now();
+        for (size_t i = 0; i < batch; ++i) benchmark.run();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        result.samples.push_back(ns / static_cast<double>(batch));
+    }
+    return result;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+/// One-sided Mann-Whitney U test (normal approximation with tie correction).
+/// Returns the p-value for "current tends to be larger than baseline".
+double mann_whitney_greater(const std::vector<double>& current, const std::vector<double>& baseline) {
+    struct Entry { double value; bool from_current; };
+    std::vector<Entry> all;
+    for (double v : current) all.push_back({v, true});
+    for (double v : baseline) all.push_back({v, false});
+    std::sort(all.begin(), all.end(), [](const Entry& a, const Entry& b) { return a.value < b.value; });
+
+    double n1 = static_cast<double>(current.size());
+    double n2 = static_cast<double>(baseline.size());
+    double n = n1 + n2;
+    double rank_sum = 0.0;
+    double tie_term = 0.0;
+    for (size_t i = 0; i < all.size();) {
+        size_t j = i;
+        while (j < all.size() && all[j].value == all[i].value) j++;
+        double average_rank = (static_cast<double>(i + j) + 1.0) / 2.0;  // Ranks are 1-based
+        for (size_t k = i; k < j; ++k) {
+            if (all[k].from_current) rank_sum += average_rank;
+        }
+        double t = static_cast<double>(j - i);
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    double u = rank_sum - n1 * (n1 + 1.0) / 2.0;
+    double mean = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_term / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+std::optional<std::vector<BenchResult>> load_baseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    auto json = Json::parse(buffer.str());
+    const Json* benchmarks = json ? json->get("benchmarks") : nullptr;
+    if (!benchmarks || !benchmarks->is_object()) {
+        return std::nullopt;
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto& [name, entry] : benchmarks->as_object()) {
+        const Json* samples = entry.get("samples_ns");
+        if (!samples || !samples->is_array()) return std::nullopt;
+        BenchResult result{name, {}};
+        for (const auto& sample : samples->as_array()) {
+            if (!sample.is_number()) return std::nullopt;
+            result.samples.push_back(sample.as_number());
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+bool save_baseline(const std::string& path, const std::vector<BenchResult>& results) {
+    Json::Object benchmarks;
+    for (const auto& result : results) {
+        Json::Array samples;
+        for (double sample : result.samples) {
+            samples.push_back(std::round(sample * 100.0) / 100.0);
+        }
+        benchmarks.emplace_back(result.name, Json::Object{{"samples_ns", std::move(samples)}});
+    }
+    std::ofstream file(path);
+    file << Json(Json::Object{{"version", 1}, {"benchmarks", std::move(benchmarks)}}).dump() << "\n";
+    return static_cast<bool>(file);
+}
+
+/// Print the comparison table, returns the number of regressions
+size_t report(const std::vector<BenchResult>& current, const std::vector<BenchResult>& baseline,
+              const GateConfig& config) {
+    std::cout << std::left << std::setw(12) << "benchmark"
+              << std::right << std::setw(16) << "baseline ns/op"
+              << std::setw(16) << "current ns/op"
+              << std::setw(10) << "change"
+              << std::setw(10) << "p-value"
+              << "  verdict" << std::endl;
+
+    size_t regressions = 0;
+    for (const auto& result : current) {
+        auto base = std::find_if(baseline.begin(), baseline.end(),
+                                 [&](const BenchResult& b) { return b.name == result.name; });
+        double now = median(result.samples);
+        std::cout << std::left << std::setw(12) << result.name << std::right << std::fixed;
+        if (base == baseline.end() || base->samples.empty()) {
+            std::cout << std::setw(16) << "-" << std::setw(16) << std::setprecision(1) << now
+                      << std::setw(10) << "-" << std::setw(10) << "-" << "  new (no baseline)" << std::endl;
+            continue;
+        }
+
+        double before = median(base->samples);
+        double change = now / before - 1.0;
+        double p_slower = mann_whitney_greater(result.samples, base->samples);
+        double p_faster = mann_whitney_greater(base->samples, result.samples);
+
+        std::string verdict = "unchanged";
+        if (p_slower < config.alpha && change > config.threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (p_faster < config.alpha && change < -config.threshold) {
+            verdict = "faster";
+        } else if (p_slower < config.alpha || p_faster < config.alpha) {
+            verdict = "within threshold";
+        }
+
+        std::ostringstream change_text;
+        change_text << std::showpos << std::fixed << std::setprecision(1) << change * 100.0 << "%";
+        std::cout << std::setw(16) << std::setprecision(1) << before
+                  << std::setw(16) << now
+                  << std::setw(10) << change_text.str()
+                  << std::setw(10) << std::setprecision(4) << std::min(p_slower, p_faster)
+                  << "  " << verdict << std::endl;
+    }
+    return regressions;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Benchmarks the lexer, parser, compiler and VM and compares them with a stored baseline.\n"
+              << "Exits with status 1 when a benchmark regresses.\n"
+              << "\n"
+              << "Options:\n"
+              << "  --baseline FILE    Baseline JSON (default: bench/baseline.json)\n"
+              << "  --update           Write the results as the new baseline instead of comparing\n"
+              << "  --samples N        Timed samples per benchmark (default: 15)\n"
+              << "  --threshold PCT    Median slowdown that fails the gate (default: 10)\n"
+              << "  --alpha P          Significance level of the Mann-Whitney test (default: 0.01)\n"
+              << "  --help             Show this message\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    GateConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "--update") {
+            config.update = true;
+        } else if ((arg == "--baseline" || arg == "--samples" || arg == "--threshold" || arg == "--alpha") &&
+                   i + 1 < argc) {
+            std::string value = argv[++i];
+            try {
+                if (arg == "--baseline") config.baseline_path = value;
+                else if (arg == "--samples") config.samples = std::max<size_t>(2, std::stoul(value));
+                else if (arg == "--threshold") config.threshold = std::stod(value) / 100.0;
+                else config.alpha = std::stod(value);
+            } catch (const std::exception&) {
+                std::cerr << "Error: " << arg << " expects a number" << std::endl;
+                return 2;
+            }
+        } else {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    for (const auto& benchmark : make_suite()) {
+        results.push_back(measure(benchmark, config));
+    }
+
+    if (config.update) {
+        if (!save_baseline(config.baseline_path, results)) {
+            std::cerr << "Error: Could not write baseline " << config.baseline_path << std::endl;
+            return 2;
+        }
+        std::cout << "Wrote baseline " << config.baseline_path << std::endl;
+        return 0;
+    }
+
+    auto baseline = load_baseline(config.baseline_path);
+    if (!baseline) {
+        std::cerr << "Error: Could not read baseline " << config.baseline_path
+                  << " (create one with --update)" << std::endl;
+        return 2;
+    }
+
+    size_t regressions = report(results, *baseline, config);
+    std::cout << std::endl;
+    if (regressions > 0) {
+        std::cout << "FAILED: " << regressions << " benchmark(s) regressed by more than "
+                  << std::setprecision(0) << config.threshold * 100.0 << "%" << std::endl;
+        return 1;
+    }
+    std::cout << "No regressions beyond " << std::setprecision(0) << config.threshold * 100.0 << "%" << std::endl;
+    return 0;
+}
\ No newline at end of file
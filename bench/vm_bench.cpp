@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <vector>
+#include "../src/chunk.h"
+#include "../src/vm.h"
+#include "../src/metrics.h"
+
+using namespace dacite;
+
+// Simple benchmark harness
+using Clock = std::chrono::steady_clock;
+
+// Build a chunk that sums `additions` ones: 0 + 1 + 1 + ...
+Chunk make_sum_chunk(size_t additions) {
+    Chunk chunk;
+    size_t zero = chunk.add_constant(Value(0));
+    size_t one = chunk.add_constant(Value(1));
+    chunk.write_opcode(OpCode::OP_CONSTANT);
+    chunk.write_byte(static_cast<uint8_t>(zero));
+    for (size_t i = 0; i < additions; ++i) {
+        chunk.write_opcode(OpCode::OP_CONSTANT);
+        chunk.write_byte(static_cast<uint8_t>(one));
+        chunk.write_opcode(OpCode::OP_ADD);
+    }
+    chunk.write_opcode(OpCode::OP_RETURN);
+    return chunk;
+}
+
+// Build a chunk that pushes `depth` mixed integer and boolean constants and folds
+// them with OP_EQUAL, exercising deep stack traffic through generic Value comparison
+Chunk make_stack_chunk(size_t depth) {
+    Chunk chunk;
+    size_t constants[] = {
+        chunk.add_constant(Value(7)),
+        chunk.add_constant(Value(true)),
+        chunk.add_constant(Value(-3)),
+        chunk.add_constant(Value(false)),
+    };
+    for (size_t i = 0; i < depth; ++i) {
+        chunk.write_opcode(OpCode::OP_CONSTANT);
+        chunk.write_byte(static_cast<uint8_t>(constants[i % 4]));
+    }
+    for (size_t i = 1; i < depth; ++i) {
+        chunk.write_opcode(OpCode::OP_EQUAL);
+    }
+    chunk.write_opcode(OpCode::OP_RETURN);
+    return chunk;
+}
+
+// Instructions executed by one run; the VM only counts them under a metrics sink
+uint64_t count_instructions(const Chunk& chunk) {
+    Metrics metrics;
+    VMConfig config;
+    config.metrics = &metrics;
+    VM vm(config);
+    if (vm.run(chunk) != VMResult::OK) {
+        std::cerr << "Benchmark chunk failed: " << vm.get_error_message() << std::endl;
+        std::exit(1);
+    }
+    return vm.get_instructions_executed();
+}
+
+// Run the chunk `runs` times and return nanoseconds per executed instruction
+double bench_run(const Chunk& chunk, const VMConfig& config, size_t runs) {
+    VM vm(config);
+    uint64_t instructions = count_instructions(chunk) * runs;
+    auto start = Clock::now();
+    for (size_t i = 0; i < runs; ++i) {
+        vm.reset();
+        if (vm.run(chunk) != VMResult::OK) {
+            std::cerr << "Benchmark chunk failed: " << vm.get_error_message() << std::endl;
+            std::exit(1);
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return elapsed / static_cast<double>(instructions);
+}
+
+// Sum a bound host column `runs` times and return bytes scanned per nanosecond (GB/s)
+double bench_column_scan(size_t elements, size_t runs) {
+    std::vector<int32_t> column(elements, 1);
+    VM vm;
+    auto binding = vm.bind_column(std::span<const int32_t>(column));
+    Chunk chunk;
+    chunk.write_opcode(OpCode::OP_COLUMN_SUM);
+    chunk.write_byte(binding.slot());
+    chunk.write_opcode(OpCode::OP_RETURN);
+    
+    auto start = Clock::now();
+    for (size_t i = 0; i < runs; ++i) {
+        vm.reset();
+        if (vm.run(chunk) != VMResult::OK || vm.peek_stack_top().as_integer() != static_cast<int32_t>(elements)) {
+            std::cerr << "Column benchmark failed: " << vm.get_error_message() << std::endl;
+            std::exit(1);
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return static_cast<double>(elements * sizeof(int32_t) * runs) / elapsed;
+}
+
+// Concatenate `fragments` short strings onto "" and return nanoseconds per fragment
+double bench_concatenation(size_t fragments, size_t runs) {
+    Chunk chunk;
+    size_t empty = chunk.add_string_constant("");
+    size_t fragment = chunk.add_string_constant("fragment");
+    chunk.write_opcode(OpCode::OP_CONSTANT);
+    chunk.write_byte(static_cast<uint8_t>(empty));
+    for (size_t i = 0; i < fragments; ++i) {
+        chunk.write_opcode(OpCode::OP_CONSTANT);
+        chunk.write_byte(static_cast<uint8_t>(fragment));
+        chunk.write_opcode(OpCode::OP_ADD);
+    }
+    chunk.write_opcode(OpCode::OP_RETURN);
+    
+    VM vm;
+    auto start = Clock::now();
+    for (size_t i = 0; i < runs; ++i) {
+        vm.reset();
+        if (vm.run(chunk) != VMResult::OK || vm.peek_stack_top().as_string().size() != fragments * 8) {
+            std::cerr << "Concatenation benchmark failed: " << vm.get_error_message() << std::endl;
+            std::exit(1);
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return elapsed / static_cast<double>(fragments * runs);
+}
+
+int main(int argc, char* argv[]) {
+    size_t runs = argc > 1 ? std::stoul(argv[1]) : 2000;
+    Chunk chunk = make_sum_chunk(1000);
+
+    std::cout << "Running VM Benchmarks..." << std::endl;
+
+    // Warm up caches and the branch predictor
+    bench_run(chunk, VMConfig{}, runs / 10 + 1);
+
+    // Alternate the two configurations and keep the best round of each, so
+    // drift on a busy machine does not land on one side of the comparison
+    VMConfig plain_config;
+    Metrics metrics;
+    VMConfig metrics_config;
+    metrics_config.metrics = &metrics;
+    double plain = std::numeric_limits<double>::infinity();
+    double with_metrics = std::numeric_limits<double>::infinity();
+    for (int round = 0; round < 5; ++round) {
+        plain = std::min(plain, bench_run(chunk, plain_config, runs / 5 + 1));
+        with_metrics = std::min(with_metrics, bench_run(chunk, metrics_config, runs / 5 + 1));
+    }
+
+    // Stay below the default 256-value stack limit
+    Chunk stack_chunk = make_stack_chunk(250);
+    bench_run(stack_chunk, VMConfig{}, runs / 10 + 1);
+    double stack_traffic = bench_run(stack_chunk, plain_config, runs);
+
+    // 64 MiB, well past the last-level cache
+    size_t column_runs = runs / 200 + 1;
+    double column_scan = bench_column_scan(size_t{16} << 20, column_runs);
+
+    // One million fragments build an 8 MB string
+    double concatenation = bench_concatenation(1000000, column_runs);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  run (no metrics):   " << plain << " ns/instruction" << std::endl;
+    std::cout << "  run (with metrics): " << with_metrics << " ns/instruction" << std::endl;
+    std::cout << "  metrics overhead:   " << (with_metrics / plain - 1.0) * 100.0 << "%" << std::endl;
+    std::cout << "  stack traffic:      " << stack_traffic << " ns/instruction" << std::endl;
+    std::cout << "  column scan:        " << column_scan << " GB/s" << std::endl;
+    std::cout << "  concatenation:      " << concatenation << " ns/fragment" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Global operator new/delete replacements that feed alloc_tracker.
+// Linked only into instrumented executables (see CMakeLists.txt), never into SOURCES.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include "alloc_tracker.h"
+
+namespace {
+
+// Each block is prefixed with its size so unsized delete can update live bytes.
+// Over-aligned blocks (std::pmr::new_delete_resource uses these) pad the prefix to the alignment.
+constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+std::size_t header_for(std::size_t alignment) {
+    return std::max(HEADER, alignment);
+}
+
+void* allocate(std::size_t size, std::size_t alignment = HEADER) {
+    std::size_t header = header_for(alignment);
+    void* memory = header == HEADER
+        ? std::malloc(size + header)
+        : std::aligned_alloc(header, (size + 2 * header - 1) / header * header);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    auto* block = static_cast<unsigned char*>(memory);
+    *reinterpret_cast<std::size_t*>(block) = size;
+    dacite::alloc_tracker::record_allocation(size);
+    return block + header;
+}
+
+void deallocate(void* ptr, std::size_t alignment = HEADER) noexcept {
+    if (!ptr) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(ptr) - header_for(alignment);
+    dacite::alloc_tracker::record_deallocation(*reinterpret_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+template <typename Allocate>
+void* allocate_nothrow(Allocate&& allocate_fn) noexcept {
+    try {
+        return allocate_fn();
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+// Lets alloc_tracker report whether this executable is instrumented
+const bool installed = (dacite::alloc_tracker::enable(), true);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate_nothrow([&] { return allocate(size); });
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate_nothrow([&] { return allocate(size); });
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow([&] { return allocate(size, static_cast<std::size_t>(alignment)); });
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate_nothrow([&] { return allocate(size, static_cast<std::size_t>(alignment)); });
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocate(ptr, static_cast<std::size_t>(alignment));
+}
\ No newline at end of file
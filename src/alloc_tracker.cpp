@@ -0,0 +1,88 @@
+#include "alloc_tracker.h"
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace dacite {
+
+namespace {
+
+std::atomic<bool> enabled{false};
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> bytes{0};
+std::atomic<uint64_t> live{0};
+
+/// The calling thread's counters, which scopes measure. Plain data with no
+/// constructor or destructor, so the hook can use it at any point of a
+/// thread's life. `live` goes negative on threads that free others' memory.
+struct ThreadCounters {
+    uint64_t allocations;
+    uint64_t bytes;
+    int64_t live;
+    int64_t peak;
+};
+
+thread_local ThreadCounters local{};
+
+} // namespace
+
+namespace alloc_tracker {
+
+void enable() {
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void record_allocation(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    live.fetch_add(size, std::memory_order_relaxed);
+    
+    local.allocations++;
+    local.bytes += size;
+    local.live += static_cast<int64_t>(size);
+    local.peak = std::max(local.peak, local.live);
+}
+
+void record_deallocation(size_t size) {
+    live.fetch_sub(size, std::memory_order_relaxed);
+    local.live -= static_cast<int64_t>(size);
+}
+
+bool is_enabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t allocation_count() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t allocated_bytes() {
+    return bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t live_bytes() {
+    return live.load(std::memory_order_relaxed);
+}
+
+} // namespace alloc_tracker
+
+AllocationScope::AllocationScope()
+    : start_allocations_(local.allocations)
+    , start_bytes_(local.bytes)
+    , start_live_(local.live)
+    , saved_peak_(std::exchange(local.peak, local.live)) {}
+
+AllocationScope::~AllocationScope() {
+    // Fold this scope's peak back into the enclosing one
+    local.peak = std::max(saved_peak_, local.peak);
+}
+
+AllocationStats AllocationScope::stats() const {
+    AllocationStats result;
+    result.allocations = local.allocations - start_allocations_;
+    result.bytes = local.bytes - start_bytes_;
+    result.peak_live_bytes = local.peak > start_live_ ? static_cast<uint64_t>(local.peak - start_live_) : 0;
+    return result;
+}
+
+} // namespace dacite
\ No newline at end of file
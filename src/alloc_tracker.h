@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dacite {
+
+/// Allocation totals for a region of code
+struct AllocationStats {
+    uint64_t allocations = 0;       // Calls to operator new
+    uint64_t bytes = 0;             // Bytes requested
+    uint64_t peak_live_bytes = 0;   // Highest live heap above the region's starting point
+};
+
+/// Process-wide allocation counters, fed by the global operator new/delete
+/// replacements in alloc_hook.cpp. Only executables that link that file
+/// (the CLI, tests and benchmarks) are instrumented; elsewhere the counters stay at zero.
+namespace alloc_tracker {
+
+/// Called by the hook when it is installed and on every allocation and deallocation
+void enable();
+void record_allocation(size_t size);
+void record_deallocation(size_t size);
+
+/// Check if the hook is linked into this executable
+bool is_enabled();
+
+/// Current totals since process start
+uint64_t allocation_count();
+uint64_t allocated_bytes();
+uint64_t live_bytes();
+
+} // namespace alloc_tracker
+
+/// RAII scope measuring the calling thread's allocations since construction.
+/// Scopes nest: an inner scope does not hide its peak from the outer one.
+/// Each thread keeps its own counters, so scopes on different threads never
+/// see each other's allocations or peaks; a scope must be created, queried
+/// and destroyed on one thread. Memory freed by another thread than the one
+/// that allocated it lowers that other thread's live count instead.
+class AllocationScope {
+public:
+    AllocationScope();
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    /// Allocation totals so far
+    AllocationStats stats() const;
+
+private:
+    uint64_t start_allocations_;
+    uint64_t start_bytes_;
+    int64_t start_live_;
+    int64_t saved_peak_;           // Enclosing scope's peak, restored on destruction
+};
+
+} // namespace dacite
\ No newline at end of file
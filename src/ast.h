@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
 #include "source_span.h"
@@ -46,7 +48,13 @@ enum class ASTNodeType {
     RETURN_STATEMENT,
     BLOCK_STATEMENT,
     INTEGER_LITERAL,
+    FLOAT_LITERAL,
+    STRING_LITERAL,
+    CALL_EXPRESSION,
+    EXPRESSION_STATEMENT,
     BINARY_EXPRESSION,
+    ERROR_EXPRESSION,
+    ERROR_STATEMENT,
     TYPE
 };
 
@@ -99,19 +107,69 @@ public:
     }
 };
 
-/// Integer literal expression
+/// Integer literal expression; `value` is the source text, `number` the value the lexer decoded
 class IntegerLiteral : public Expression {
 public:
     std::string value;
+    uint64_t number;
 
-    IntegerLiteral(const std::string& value, const SourceSpan& span)
-        : Expression(ASTNodeType::INTEGER_LITERAL, span), value(value) {}
+    IntegerLiteral(const std::string& value, uint64_t number, const SourceSpan& span)
+        : Expression(ASTNodeType::INTEGER_LITERAL, span), value(value), number(number) {}
 
     std::string to_string() const override {
         return "IntegerLiteral(" + value + ")";
     }
 };
 
+/// Floating-point literal expression; `value` is the source text, `number` the value the lexer decoded
+class FloatLiteral : public Expression {
+public:
+    std::string value;
+    double number;
+
+    FloatLiteral(const std::string& value, double number, const SourceSpan& span)
+        : Expression(ASTNodeType::FLOAT_LITERAL, span), value(value), number(number) {}
+
+    std::string to_string() const override {
+        return "FloatLiteral(" + value + ")";
+    }
+};
+
+/// String literal expression; `value` has its escapes already processed
+class StringLiteral : public Expression {
+public:
+    std::string value;
+
+    StringLiteral(std::string value, const SourceSpan& span)
+        : Expression(ASTNodeType::STRING_LITERAL, span), value(std::move(value)) {}
+
+    std::string to_string() const override {
+        return "StringLiteral(\"" + value + "\")";
+    }
+};
+
+/// Call of a named function (e.g., print("hi"))
+class CallExpression : public Expression {
+public:
+    std::string callee;
+    std::vector<ExpressionPtr> arguments;
+
+    CallExpression(std::string callee, std::vector<ExpressionPtr> arguments, const SourceSpan& span)
+        : Expression(ASTNodeType::CALL_EXPRESSION, span)
+        , callee(std::move(callee))
+        , arguments(std::move(arguments)) {}
+
+    std::string to_string() const override {
+        std::string result = "CallExpression(" + callee + ", [";
+        for (size_t i = 0; i < arguments.size(); ++i) {
+            if (i > 0) result += ", ";
+            result += arguments[i]->to_string();
+        }
+        result += "])";
+        return result;
+    }
+};
+
 /// Binary expression (e.g., a + b, x == y)
 class BinaryExpression : public Expression {
 public:
@@ -131,6 +189,41 @@ public:
     }
 };
 
+/// Placeholder for an expression that failed to parse
+class ErrorExpression : public Expression {
+public:
+    explicit ErrorExpression(const SourceSpan& span)
+        : Expression(ASTNodeType::ERROR_EXPRESSION, span) {}
+
+    std::string to_string() const override {
+        return "ErrorExpression";
+    }
+};
+
+/// Placeholder for a statement that failed to parse, spanning the tokens skipped to recover
+class ErrorStatement : public Statement {
+public:
+    explicit ErrorStatement(const SourceSpan& span)
+        : Statement(ASTNodeType::ERROR_STATEMENT, span) {}
+
+    std::string to_string() const override {
+        return "ErrorStatement";
+    }
+};
+
+/// Expression evaluated for its side effects (e.g., print("hi");)
+class ExpressionStatement : public Statement {
+public:
+    ExpressionPtr expression;
+
+    ExpressionStatement(ExpressionPtr expression, const SourceSpan& span)
+        : Statement(ASTNodeType::EXPRESSION_STATEMENT, span), expression(std::move(expression)) {}
+
+    std::string to_string() const override {
+        return "ExpressionStatement(" + expression->to_string() + ")";
+    }
+};
+
 /// Package declaration
 class PackageDeclaration : public Declaration {
 public:
@@ -147,10 +240,10 @@ public:
 /// Block statement containing a list of statements
 class BlockStatement : public Statement {
 public:
-    std::vector<StatementPtr> statements;
+    std::pmr::vector<StatementPtr> statements;
 
-    BlockStatement(const SourceSpan& span)
-        : Statement(ASTNodeType::BLOCK_STATEMENT, span) {}
+    BlockStatement(const SourceSpan& span, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : Statement(ASTNodeType::BLOCK_STATEMENT, span), statements(resource) {}
 
     void add_statement(StatementPtr statement) {
         statements.push_back(std::move(statement));
@@ -194,6 +287,7 @@ public:
     std::vector<std::string> parameters;  // Simplified for now
     std::unique_ptr<Type> return_type;
     std::unique_ptr<BlockStatement> body;
+    SourceSpan name_span;                 // Span of the function name
 
     FunctionDeclaration(const std::string& function_name, 
                        std::unique_ptr<Type> return_type,
@@ -4,12 +4,45 @@
 
 namespace dacite {
 
-void Chunk::write_byte(uint8_t byte) {
+std::string_view opcode_to_string(OpCode opcode) {
+    switch (opcode) {
+        case OpCode::OP_CONSTANT:          return "OP_CONSTANT";
+        case OpCode::OP_RETURN:            return "OP_RETURN";
+        case OpCode::OP_ADD:               return "OP_ADD";
+        case OpCode::OP_SUBTRACT:          return "OP_SUBTRACT";
+        case OpCode::OP_MULTIPLY:          return "OP_MULTIPLY";
+        case OpCode::OP_DIVIDE:            return "OP_DIVIDE";
+        case OpCode::OP_EQUAL:             return "OP_EQUAL";
+        case OpCode::OP_NOT_EQUAL:         return "OP_NOT_EQUAL";
+        case OpCode::OP_LESS:              return "OP_LESS";
+        case OpCode::OP_LESS_EQUAL:        return "OP_LESS_EQUAL";
+        case OpCode::OP_GREATER:           return "OP_GREATER";
+        case OpCode::OP_GREATER_EQUAL:     return "OP_GREATER_EQUAL";
+        case OpCode::OP_ADD_CONSTANT:      return "OP_ADD_CONSTANT";
+        case OpCode::OP_SUBTRACT_CONSTANT: return "OP_SUBTRACT_CONSTANT";
+        case OpCode::OP_MULTIPLY_CONSTANT: return "OP_MULTIPLY_CONSTANT";
+        case OpCode::OP_COLUMN_LENGTH:     return "OP_COLUMN_LENGTH";
+        case OpCode::OP_COLUMN_GET:        return "OP_COLUMN_GET";
+        case OpCode::OP_COLUMN_SUM:        return "OP_COLUMN_SUM";
+        case OpCode::OP_POP:               return "OP_POP";
+        case OpCode::OP_PRINT:             return "OP_PRINT";
+        case OpCode::OP_READ_LINE:         return "OP_READ_LINE";
+        case OpCode::OP_FIND:              return "OP_FIND";
+        case OpCode::OP_SPLIT:             return "OP_SPLIT";
+        case OpCode::OP_EQUALS_IGNORE_CASE: return "OP_EQUALS_IGNORE_CASE";
+        case OpCode::OP_IS_UTF8:           return "OP_IS_UTF8";
+        case OpCode::OP_COUNT_LINES:       return "OP_COUNT_LINES";
+    }
+    return "UNKNOWN_OP";
+}
+
+void Chunk::write_byte(uint8_t byte, size_t line) {
     code_.push_back(byte);
+    lines_.push_back(static_cast<uint32_t>(line));
 }
 
-void Chunk::write_opcode(OpCode opcode) {
-    write_byte(static_cast<uint8_t>(opcode));
+void Chunk::write_opcode(OpCode opcode, size_t line) {
+    write_byte(static_cast<uint8_t>(opcode), line);
 }
 
 size_t Chunk::add_constant(const Value& value) {
@@ -17,6 +50,11 @@ size_t Chunk::add_constant(const Value& value) {
     return constants_.size() - 1;
 }
 
+size_t Chunk::add_string_constant(std::string text) {
+    strings_.push_back(StringObject::make_static(std::move(text)));
+    return add_constant(Value(StringRef(strings_.back().get())));
+}
+
 const Value& Chunk::get_constant(size_t index) const {
     if (index >= constants_.size()) {
         throw std::out_of_range("Constant index out of range");
@@ -24,9 +62,16 @@ const Value& Chunk::get_constant(size_t index) const {
     return constants_[index];
 }
 
+size_t Chunk::get_line(size_t offset) const {
+    return offset < lines_.size() ? lines_[offset] : 0;
+}
+
 void Chunk::clear() {
     code_.clear();
     constants_.clear();
+    strings_.clear();
+    lines_.clear();
+    name_.clear();
 }
 
 std::string Chunk::to_string() const {
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <memory_resource>
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include "value.h"
 
 namespace dacite {
@@ -24,47 +28,93 @@ enum class OpCode : uint8_t {
     OP_LESS_EQUAL,      // Pop two values, compare less or equal, push result
     OP_GREATER,         // Pop two values, compare greater than, push result
     OP_GREATER_EQUAL,   // Pop two values, compare greater or equal, push result
+    
+    // Superinstructions (selected by the compiler from a profile)
+    OP_ADD_CONSTANT,      // Add a constant to the top of the stack
+    OP_SUBTRACT_CONSTANT, // Subtract a constant from the top of the stack
+    OP_MULTIPLY_CONSTANT, // Multiply the top of the stack by a constant
+    
+    // Host columns (operand: column slot, see VM::bind_column)
+    OP_COLUMN_LENGTH,     // Push the column's length
+    OP_COLUMN_GET,        // Pop an index, push that element
+    OP_COLUMN_SUM,        // Push the sum of all elements
+    
+    // Statements and builtins
+    OP_POP,               // Discard the top of the stack
+    OP_PRINT,             // Pop a value, write it and a newline to the VM's output, push nil
+    OP_READ_LINE,         // Push the next line of the VM's input, or nil at end of input
+    
+    // String builtins
+    OP_FIND,              // Pop a pattern and a string, push the pattern's byte offset or -1
+    OP_SPLIT,             // Pop an index, a separator and a string, push that field (a slice) or nil
+    OP_EQUALS_IGNORE_CASE, // Pop two strings, push whether they match ignoring ASCII case
+    OP_IS_UTF8,           // Pop a string, push whether it is valid UTF-8
+    OP_COUNT_LINES,       // Pop a string, push its number of lines
 };
 
+/// Number of opcodes (keep in sync with the last OpCode)
+constexpr size_t OPCODE_COUNT = static_cast<size_t>(OpCode::OP_COUNT_LINES) + 1;
+
+/// Convert opcode to string for debugging
+std::string_view opcode_to_string(OpCode opcode);
+
 /// A chunk of bytecode with associated constants
 class Chunk {
 public:
-    /// Default constructor
-    Chunk() = default;
+    /// Create a chunk whose code, constants and line table allocate from `resource`
+    explicit Chunk(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : code_(resource), strings_(resource), constants_(resource), lines_(resource) {}
     
-    /// Write a byte to the chunk
-    void write_byte(uint8_t byte);
+    /// Write a byte to the chunk, tagged with its source line (0 if unknown)
+    void write_byte(uint8_t byte, size_t line = 0);
     
-    /// Write an opcode to the chunk
-    void write_opcode(OpCode opcode);
+    /// Write an opcode to the chunk, tagged with its source line (0 if unknown)
+    void write_opcode(OpCode opcode, size_t line = 0);
     
     /// Add a constant to the constant pool and return its index
     size_t add_constant(const Value& value);
     
+    /// Add a string constant owned by this chunk and return its index.
+    /// Its values are not reference counted, so VMs on several threads may
+    /// run the chunk at once; VM::run copies any that are left on its stack.
+    size_t add_string_constant(std::string text);
+    
     /// Get the bytecode
-    const std::vector<uint8_t>& get_code() const { return code_; }
+    const std::pmr::vector<uint8_t>& get_code() const { return code_; }
     
     /// Get the constants
-    const std::vector<Value>& get_constants() const { return constants_; }
+    const std::pmr::vector<Value>& get_constants() const { return constants_; }
     
     /// Get a constant by index
     const Value& get_constant(size_t index) const;
     
+    /// Get the source line of the byte at an offset (0 if unknown)
+    size_t get_line(size_t offset) const;
+    
+    /// Set the name of the function this chunk was compiled from
+    void set_name(std::string name) { name_ = std::move(name); }
+    
+    /// Get the name of the function this chunk was compiled from
+    const std::string& get_name() const { return name_; }
+    
     /// Get the size of the bytecode
     size_t size() const { return code_.size(); }
     
     /// Check if chunk is empty
     bool empty() const { return code_.empty(); }
     
-    /// Clear the chunk
+    /// Clear the chunk, keeping its buffers' capacity for reuse
     void clear();
     
     /// Debug: Convert chunk to string representation
     std::string to_string() const;
 
 private:
-    std::vector<uint8_t> code_;        // Bytecode instructions
-    std::vector<Value> constants_;     // Constant pool
+    std::pmr::vector<uint8_t> code_;     // Bytecode instructions
+    std::pmr::vector<std::unique_ptr<StringObject>> strings_; // String constants; outlive constants_
+    std::pmr::vector<Value> constants_;  // Constant pool
+    std::pmr::vector<uint32_t> lines_;   // Source line for each byte of code_
+    std::string name_;                 // Function name for symbolization
 };
 
 } // namespace dacite
\ No newline at end of file
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include "ast.h"
+#include "chunk.h"
+#include "compiler.h"
+#include "value.h"
+
+namespace dacite {
+
+/// Typed expression nodes for ChunkBuilder.
+///
+/// Expressions are plain values whose C++ type records their shape and
+/// dacite type, so ill-typed expressions (adding a boolean, ordering
+/// booleans, comparing an integer with a boolean) do not compile, and
+/// constant subexpressions fold in constexpr code.
+namespace build {
+
+enum class ExprType {
+    INTEGER,
+    BOOLEAN
+};
+
+/// Result of folding an expression; booleans are held as 0 or 1
+struct Folded {
+    bool constant = false;      // False when the value is only known at runtime
+    int32_t value = 0;
+};
+
+struct IntegerLiteral {
+    static constexpr ExprType type = ExprType::INTEGER;
+    int32_t value;
+
+    constexpr Folded fold() const { return {true, value}; }
+};
+
+struct BooleanLiteral {
+    static constexpr ExprType type = ExprType::BOOLEAN;
+    bool value;
+
+    constexpr Folded fold() const { return {true, value ? 1 : 0}; }
+};
+
+constexpr bool is_comparison(BinaryOperator op) {
+    return op != BinaryOperator::ADD && op != BinaryOperator::SUBTRACT &&
+           op != BinaryOperator::MULTIPLY && op != BinaryOperator::DIVIDE;
+}
+
+template <BinaryOperator Op, typename Left, typename Right>
+struct Binary {
+    static constexpr ExprType type = is_comparison(Op) ? ExprType::BOOLEAN : ExprType::INTEGER;
+    static constexpr BinaryOperator op = Op;
+    Left left;
+    Right right;
+
+    /// Fold with the VM's semantics; division by zero is left for the VM to report
+    constexpr Folded fold() const {
+        Folded a = left.fold();
+        Folded b = right.fold();
+        if (!a.constant || !b.constant) {
+            return {};
+        }
+        switch (Op) {
+            case BinaryOperator::ADD:           return {true, wrapping_add(a.value, b.value)};
+            case BinaryOperator::SUBTRACT:      return {true, wrapping_subtract(a.value, b.value)};
+            case BinaryOperator::MULTIPLY:      return {true, wrapping_multiply(a.value, b.value)};
+            case BinaryOperator::DIVIDE:
+                if (b.value == 0) {
+                    return {};
+                }
+                return {true, wrapping_divide(a.value, b.value)};
+            case BinaryOperator::EQUAL:         return {true, a.value == b.value};
+            case BinaryOperator::NOT_EQUAL:     return {true, a.value != b.value};
+            case BinaryOperator::LESS_THAN:     return {true, a.value < b.value};
+            case BinaryOperator::LESS_EQUAL:    return {true, a.value <= b.value};
+            case BinaryOperator::GREATER_THAN:  return {true, a.value > b.value};
+            case BinaryOperator::GREATER_EQUAL: return {true, a.value >= b.value};
+        }
+        return {};
+    }
+};
+
+template <typename T>
+concept Expr = requires(const T& expr) {
+    { T::type } -> std::convertible_to<ExprType>;
+    { expr.fold() } -> std::same_as<Folded>;
+};
+
+/// Operands may be expressions or plain C++ int32_t and bool values; other
+/// integer types would silently wrap, so they must be converted explicitly
+template <typename T>
+concept Operand = Expr<T> || std::same_as<T, int32_t> || std::same_as<T, bool>;
+
+template <Operand T>
+constexpr auto as_expr(T operand) {
+    if constexpr (Expr<T>) {
+        return operand;
+    } else if constexpr (std::same_as<T, bool>) {
+        return BooleanLiteral{operand};
+    } else {
+        return IntegerLiteral{operand};
+    }
+}
+
+template <typename T>
+inline constexpr ExprType operand_type = decltype(as_expr(std::declval<T>()))::type;
+
+// At least one side must be an expression so plain C++ arithmetic is untouched
+template <typename L, typename R>
+concept IntegerOperands = Operand<L> && Operand<R> && (Expr<L> || Expr<R>) &&
+                          operand_type<L> == ExprType::INTEGER && operand_type<R> == ExprType::INTEGER;
+
+template <typename L, typename R>
+concept MatchingOperands = Operand<L> && Operand<R> && (Expr<L> || Expr<R>) &&
+                           operand_type<L> == operand_type<R>;
+
+template <BinaryOperator Op, typename L, typename R>
+constexpr auto make_binary(L left, R right) {
+    return Binary<Op, decltype(as_expr(left)), decltype(as_expr(right))>{as_expr(left), as_expr(right)};
+}
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator+(L left, R right) { return make_binary<BinaryOperator::ADD>(left, right); }
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator-(L left, R right) { return make_binary<BinaryOperator::SUBTRACT>(left, right); }
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator*(L left, R right) { return make_binary<BinaryOperator::MULTIPLY>(left, right); }
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator/(L left, R right) { return make_binary<BinaryOperator::DIVIDE>(left, right); }
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator<(L left, R right) { return make_binary<BinaryOperator::LESS_THAN>(left, right); }
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator<=(L left, R right) { return make_binary<BinaryOperator::LESS_EQUAL>(left, right); }
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator>(L left, R right) { return make_binary<BinaryOperator::GREATER_THAN>(left, right); }
+
+template <typename L, typename R> requires IntegerOperands<L, R>
+constexpr auto operator>=(L left, R right) { return make_binary<BinaryOperator::GREATER_EQUAL>(left, right); }
+
+template <typename L, typename R> requires MatchingOperands<L, R>
+constexpr auto operator==(L left, R right) { return make_binary<BinaryOperator::EQUAL>(left, right); }
+
+template <typename L, typename R> requires MatchingOperands<L, R>
+constexpr auto operator!=(L left, R right) { return make_binary<BinaryOperator::NOT_EQUAL>(left, right); }
+
+} // namespace build
+
+/// Builds chunks from typed C++ expressions instead of source text:
+///
+///     ChunkBuilder builder;
+///     Chunk chunk;
+///     builder.fn("f", chunk, [](auto& b) { return b.lit(1) + b.lit(20) * 2 > 40; });
+///
+/// Constant subexpressions are folded, integer operands known to be
+/// constants use the OP_*_CONSTANT superinstructions (the operand types are
+/// checked statically, so no profile is needed), and constants are shared.
+class ChunkBuilder {
+public:
+    /// Leaf expressions
+    static constexpr build::IntegerLiteral lit(int32_t value) { return {value}; }
+    static constexpr build::BooleanLiteral lit(bool value) { return {value}; }
+
+    /// Replace `chunk` with a function named `name` returning the expression built by `body(*this)`
+    template <typename Body>
+    CompileResult fn(std::string name, Chunk& chunk, Body&& body) {
+        auto expression = std::forward<Body>(body)(*this);
+        static_assert(build::Expr<decltype(expression)>, "fn bodies must return a builder expression");
+
+        error_message_.clear();
+        chunk.clear();
+        chunk.set_name(std::move(name));
+        if (emit(expression, chunk) != CompileResult::OK) {
+            return CompileResult::ERROR;
+        }
+        chunk.write_opcode(OpCode::OP_RETURN);
+        return CompileResult::OK;
+    }
+
+    /// Get any error message from the last fn()
+    const std::string& get_error_message() const { return error_message_; }
+
+    /// Check if the last fn() failed
+    bool has_errors() const { return !error_message_.empty(); }
+
+private:
+    std::string error_message_;
+
+    template <build::Expr E>
+    CompileResult emit(const E& expression, Chunk& chunk) {
+        if (build::Folded folded = expression.fold(); folded.constant) {
+            return emit_constant(OpCode::OP_CONSTANT, to_value<E::type>(folded), chunk);
+        }
+        if constexpr (requires { E::op; }) {
+            if (emit(expression.left, chunk) != CompileResult::OK) {
+                return CompileResult::ERROR;
+            }
+            build::Folded right = expression.right.fold();
+            OpCode superinstruction = constant_opcode(E::op);
+            if (right.constant && superinstruction != OpCode::OP_CONSTANT) {
+                return emit_constant(superinstruction, Value(right.value), chunk);
+            }
+            if (emit(expression.right, chunk) != CompileResult::OK) {
+                return CompileResult::ERROR;
+            }
+            chunk.write_opcode(binary_opcode(E::op));
+        }
+        return CompileResult::OK;
+    }
+
+    CompileResult emit_constant(OpCode opcode, const Value& value, Chunk& chunk) {
+        size_t index = 0;
+        const auto& constants = chunk.get_constants();
+        while (index < constants.size() && constants[index] != value) {
+            ++index;
+        }
+        if (index > 255) {
+            error_message_ = "Too many constants";
+            return CompileResult::ERROR;
+        }
+        if (index == constants.size()) {
+            chunk.add_constant(value);
+        }
+        chunk.write_opcode(opcode);
+        chunk.write_byte(static_cast<uint8_t>(index));
+        return CompileResult::OK;
+    }
+
+    template <build::ExprType Type>
+    static Value to_value(const build::Folded& folded) {
+        if constexpr (Type == build::ExprType::BOOLEAN) {
+            return Value(folded.value != 0);
+        } else {
+            return Value(folded.value);
+        }
+    }
+
+    // The superinstruction taking an integer constant right operand, or OP_CONSTANT if none
+    static constexpr OpCode constant_opcode(BinaryOperator op) {
+        switch (op) {
+            case BinaryOperator::ADD:      return OpCode::OP_ADD_CONSTANT;
+            case BinaryOperator::SUBTRACT: return OpCode::OP_SUBTRACT_CONSTANT;
+            case BinaryOperator::MULTIPLY: return OpCode::OP_MULTIPLY_CONSTANT;
+            default:                       return OpCode::OP_CONSTANT;
+        }
+    }
+
+    static constexpr OpCode binary_opcode(BinaryOperator op) {
+        switch (op) {
+            case BinaryOperator::ADD:           return OpCode::OP_ADD;
+            case BinaryOperator::SUBTRACT:      return OpCode::OP_SUBTRACT;
+            case BinaryOperator::MULTIPLY:      return OpCode::OP_MULTIPLY;
+            case BinaryOperator::DIVIDE:        return OpCode::OP_DIVIDE;
+            case BinaryOperator::EQUAL:         return OpCode::OP_EQUAL;
+            case BinaryOperator::NOT_EQUAL:     return OpCode::OP_NOT_EQUAL;
+            case BinaryOperator::LESS_THAN:     return OpCode::OP_LESS;
+            case BinaryOperator::LESS_EQUAL:    return OpCode::OP_LESS_EQUAL;
+            case BinaryOperator::GREATER_THAN:  return OpCode::OP_GREATER;
+            case BinaryOperator::GREATER_EQUAL: return OpCode::OP_GREATER_EQUAL;
+        }
+        return OpCode::OP_RETURN;
+    }
+};
+
+} // namespace dacite
\ No newline at end of file
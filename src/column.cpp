@@ -0,0 +1,79 @@
+#include "column.h"
+#include "vm.h"
+
+namespace dacite {
+
+ValueType Column::element_type() const {
+    if (std::holds_alternative<std::span<const int32_t>>(data_)) {
+        return ValueType::INTEGER;
+    } else if (std::holds_alternative<std::span<const double>>(data_)) {
+        return ValueType::FLOAT;
+    }
+    return ValueType::NIL;
+}
+
+size_t Column::size() const {
+    if (const auto* integers = std::get_if<std::span<const int32_t>>(&data_)) {
+        return integers->size();
+    } else if (const auto* doubles = std::get_if<std::span<const double>>(&data_)) {
+        return doubles->size();
+    }
+    return 0;
+}
+
+Value Column::get(size_t index) const {
+    if (const auto* integers = std::get_if<std::span<const int32_t>>(&data_)) {
+        return Value((*integers)[index]);
+    }
+    return Value(std::get<std::span<const double>>(data_)[index]);
+}
+
+Value Column::sum() const {
+    if (const auto* integers = std::get_if<std::span<const int32_t>>(&data_)) {
+        // Unsigned so the loop wraps without UB and vectorizes
+        uint32_t total = 0;
+        for (int32_t value : *integers) {
+            total += static_cast<uint32_t>(value);
+        }
+        return Value(static_cast<int32_t>(total));
+    }
+
+    // Independent partial sums break the dependency on a single accumulator
+    std::span<const double> doubles = std::get<std::span<const double>>(data_);
+    double lanes[4] = {0.0, 0.0, 0.0, 0.0};
+    size_t i = 0;
+    for (; i + 4 <= doubles.size(); i += 4) {
+        lanes[0] += doubles[i];
+        lanes[1] += doubles[i + 1];
+        lanes[2] += doubles[i + 2];
+        lanes[3] += doubles[i + 3];
+    }
+    for (; i < doubles.size(); ++i) {
+        lanes[0] += doubles[i];
+    }
+    return Value((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+ColumnBinding::ColumnBinding(ColumnBinding&& other) noexcept
+    : vm_(other.vm_), slot_(other.slot_) {
+    other.vm_ = nullptr;
+}
+
+ColumnBinding& ColumnBinding::operator=(ColumnBinding&& other) noexcept {
+    if (this != &other) {
+        release();
+        vm_ = other.vm_;
+        slot_ = other.slot_;
+        other.vm_ = nullptr;
+    }
+    return *this;
+}
+
+void ColumnBinding::release() {
+    if (vm_) {
+        vm_->unbind_column(slot_);
+        vm_ = nullptr;
+    }
+}
+
+} // namespace dacite
\ No newline at end of file
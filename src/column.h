@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <variant>
+#include "value.h"
+
+namespace dacite {
+
+class VM;
+
+/// Read-only view of a host array of integers or doubles.
+/// Elements are read in place; only values handed to the VM stack are boxed.
+class Column {
+public:
+    /// An unbound column
+    Column() = default;
+
+    explicit Column(std::span<const int32_t> values) : data_(values) {}
+    explicit Column(std::span<const double> values) : data_(values) {}
+
+    /// Check if this column views host memory
+    bool is_bound() const { return !std::holds_alternative<std::monostate>(data_); }
+
+    /// INTEGER or FLOAT (NIL when unbound)
+    ValueType element_type() const;
+
+    /// Number of elements
+    size_t size() const;
+
+    /// Box one element (index must be in range)
+    Value get(size_t index) const;
+
+    /// Sum of all elements: integers wrap like OP_ADD, doubles are summed in four lanes
+    Value sum() const;
+
+private:
+    std::variant<std::monostate, std::span<const int32_t>, std::span<const double>> data_;
+};
+
+/// Keeps a column bound to one of a VM's column slots and unbinds it when destroyed.
+/// Chunks address the column by slot(); the VM must outlive the binding and not move.
+class ColumnBinding {
+public:
+    ColumnBinding() = default;
+    ColumnBinding(VM* vm, uint8_t slot) : vm_(vm), slot_(slot) {}
+    ColumnBinding(ColumnBinding&& other) noexcept;
+    ColumnBinding& operator=(ColumnBinding&& other) noexcept;
+    ~ColumnBinding() { release(); }
+
+    ColumnBinding(const ColumnBinding&) = delete;
+    ColumnBinding& operator=(const ColumnBinding&) = delete;
+
+    /// Slot operand for the OP_COLUMN_* instructions
+    uint8_t slot() const { return slot_; }
+
+    /// False when the VM had no free slot
+    explicit operator bool() const { return vm_ != nullptr; }
+
+    /// Unbind now instead of at destruction
+    void release();
+
+private:
+    VM* vm_ = nullptr;
+    uint8_t slot_ = 0;
+};
+
+} // namespace dacite
\ No newline at end of file
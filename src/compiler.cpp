@@ -6,6 +6,7 @@ namespace dacite {
 Compiler::Compiler(const CompilerConfig& config) : config_(config) {}
 
 CompileResult Compiler::compile(const Program& program, Chunk& chunk) {
+    StageTimer timer(config_.metrics, Stage::COMPILE);
     debug_print("=== Compilation ===");
     error_message_.clear();
     
@@ -27,10 +28,25 @@ CompileResult Compiler::compile(const Program& program, Chunk& chunk) {
         return CompileResult::ERROR;
     }
     
-    debug_print("Compiling function: " + func_decl->function_name);
+    if (config_.debug_mode) {
+        debug_print("Compiling function: " + func_decl->function_name);
+    }
+    chunk.set_name(func_decl->function_name);
     return compile_function(*func_decl, chunk);
 }
 
+CompileResult Compiler::compile_standalone_expression(const Expression& expr, Chunk& chunk) {
+    StageTimer timer(config_.metrics, Stage::COMPILE);
+    debug_print("=== Expression Compilation ===");
+    error_message_.clear();
+    
+    if (compile_expression(expr, chunk) != CompileResult::OK) {
+        return CompileResult::ERROR;
+    }
+    chunk.write_opcode(OpCode::OP_RETURN, expr.span.start.line);
+    return CompileResult::OK;
+}
+
 CompileResult Compiler::compile_function(const FunctionDeclaration& func, Chunk& chunk) {
     // For basic implementation, we expect function to have a body
     if (!func.body) {
@@ -62,15 +78,31 @@ CompileResult Compiler::compile_statement(const Statement& stmt, Chunk& chunk) {
             } else {
                 // Return void - push nil
                 size_t nil_idx = chunk.add_constant(Value());
-                chunk.write_opcode(OpCode::OP_CONSTANT);
-                chunk.write_byte(static_cast<uint8_t>(nil_idx));
+                chunk.write_opcode(OpCode::OP_CONSTANT, stmt.span.start.line);
+                chunk.write_byte(static_cast<uint8_t>(nil_idx), stmt.span.start.line);
             }
             
             // Emit return instruction
-            chunk.write_opcode(OpCode::OP_RETURN);
+            chunk.write_opcode(OpCode::OP_RETURN, stmt.span.start.line);
+            return CompileResult::OK;
+        }
+        
+        case ASTNodeType::EXPRESSION_STATEMENT: {
+            const auto& expression_stmt = static_cast<const ExpressionStatement&>(stmt);
+            debug_print("Compiling expression statement");
+            
+            // Evaluate for its effect and discard the value
+            if (compile_expression(*expression_stmt.expression, chunk) != CompileResult::OK) {
+                return CompileResult::ERROR;
+            }
+            chunk.write_opcode(OpCode::OP_POP, stmt.span.start.line);
             return CompileResult::OK;
         }
         
+        case ASTNodeType::ERROR_STATEMENT:
+            compile_error("Cannot compile a statement with syntax errors");
+            return CompileResult::ERROR;
+        
         default:
             compile_error("Unsupported statement type");
             return CompileResult::ERROR;
@@ -81,26 +113,82 @@ CompileResult Compiler::compile_expression(const Expression& expr, Chunk& chunk)
     switch (expr.type) {
         case ASTNodeType::INTEGER_LITERAL: {
             const auto& int_literal = static_cast<const IntegerLiteral&>(expr);
-            debug_print("Compiling integer literal: " + int_literal.value);
+            if (config_.debug_mode) {
+                debug_print("Compiling integer literal: " + int_literal.value);
+            }
             
-            // Parse the integer value
-            try {
-                int32_t value = std::stoi(int_literal.value);
-                size_t const_idx = chunk.add_constant(Value(value));
-                
-                // Check if constant index fits in a byte
-                if (const_idx > 255) {
-                    compile_error("Too many constants");
+            int32_t value;
+            if (integer_literal_value(int_literal, value) != CompileResult::OK) {
+                return CompileResult::ERROR;
+            }
+            
+            uint8_t const_idx;
+            if (make_constant(Value(value), chunk, const_idx) != CompileResult::OK) {
+                return CompileResult::ERROR;
+            }
+            
+            chunk.write_opcode(OpCode::OP_CONSTANT, expr.span.start.line);
+            chunk.write_byte(const_idx, expr.span.start.line);
+            return CompileResult::OK;
+        }
+        
+        case ASTNodeType::FLOAT_LITERAL: {
+            const auto& float_literal = static_cast<const FloatLiteral&>(expr);
+            if (config_.debug_mode) {
+                debug_print("Compiling float literal: " + float_literal.value);
+            }
+            
+            uint8_t const_idx;
+            if (make_constant(Value(float_literal.number), chunk, const_idx) != CompileResult::OK) {
+                return CompileResult::ERROR;
+            }
+            
+            chunk.write_opcode(OpCode::OP_CONSTANT, expr.span.start.line);
+            chunk.write_byte(const_idx, expr.span.start.line);
+            return CompileResult::OK;
+        }
+        
+        case ASTNodeType::STRING_LITERAL: {
+            const auto& string_literal = static_cast<const StringLiteral&>(expr);
+            if (config_.debug_mode) {
+                debug_print("Compiling string literal: " + string_literal.value);
+            }
+            
+            size_t const_idx = chunk.add_string_constant(string_literal.value);
+            if (const_idx > 255) {
+                compile_error("Too many constants");
+                return CompileResult::ERROR;
+            }
+            
+            chunk.write_opcode(OpCode::OP_CONSTANT, expr.span.start.line);
+            chunk.write_byte(static_cast<uint8_t>(const_idx), expr.span.start.line);
+            return CompileResult::OK;
+        }
+        
+        case ASTNodeType::CALL_EXPRESSION: {
+            const auto& call = static_cast<const CallExpression&>(expr);
+            if (config_.debug_mode) {
+                debug_print("Compiling call: " + call.callee);
+            }
+            
+            const Builtin* builtin = find_builtin(call.callee);
+            if (!builtin) {
+                compile_error("Unknown function: " + call.callee);
+                return CompileResult::ERROR;
+            }
+            if (call.arguments.size() != builtin->arity) {
+                compile_error(call.callee + " expects " + std::to_string(builtin->arity) +
+                              " argument(s) but got " + std::to_string(call.arguments.size()));
+                return CompileResult::ERROR;
+            }
+            
+            for (const auto& argument : call.arguments) {
+                if (compile_expression(*argument, chunk) != CompileResult::OK) {
                     return CompileResult::ERROR;
                 }
-                
-                chunk.write_opcode(OpCode::OP_CONSTANT);
-                chunk.write_byte(static_cast<uint8_t>(const_idx));
-                return CompileResult::OK;
-            } catch (const std::exception& e) {
-                compile_error("Invalid integer literal: " + int_literal.value);
-                return CompileResult::ERROR;
             }
+            chunk.write_opcode(builtin->opcode, expr.span.start.line);
+            return CompileResult::OK;
         }
         
         case ASTNodeType::BINARY_EXPRESSION: {
@@ -112,42 +200,63 @@ CompileResult Compiler::compile_expression(const Expression& expr, Chunk& chunk)
                 return CompileResult::ERROR;
             }
             
+            // Fold a literal right operand into a superinstruction when the profile allows it
+            OpCode superinstruction = select_superinstruction(binary_expr);
+            if (superinstruction != OpCode::OP_CONSTANT) {
+                const auto& literal = static_cast<const IntegerLiteral&>(*binary_expr.right);
+                if (config_.debug_mode) {
+                    debug_print("Selecting superinstruction " + std::string(opcode_to_string(superinstruction)));
+                }
+                
+                int32_t value;
+                uint8_t const_idx;
+                if (integer_literal_value(literal, value) != CompileResult::OK ||
+                    make_constant(Value(value), chunk, const_idx) != CompileResult::OK) {
+                    return CompileResult::ERROR;
+                }
+                
+                chunk.write_opcode(superinstruction, expr.span.start.line);
+                chunk.write_byte(const_idx, expr.span.start.line);
+                return CompileResult::OK;
+            }
+            
             // Compile right operand
             if (compile_expression(*binary_expr.right, chunk) != CompileResult::OK) {
                 return CompileResult::ERROR;
             }
             
             // Emit the operator instruction
+            size_t line = expr.span.start.line;
             switch (binary_expr.operator_) {
                 case BinaryOperator::ADD:
-                    chunk.write_opcode(OpCode::OP_ADD);
+                    chunk.write_opcode(OpCode::OP_ADD, line);
                     break;
                 case BinaryOperator::SUBTRACT:
-                    chunk.write_opcode(OpCode::OP_SUBTRACT);
+                    chunk.write_opcode(OpCode::OP_SUBTRACT, line);
                     break;
                 case BinaryOperator::MULTIPLY:
-                    chunk.write_opcode(OpCode::OP_MULTIPLY);
+                    chunk.write_opcode(OpCode::OP_MULTIPLY, line);
                     break;
                 case BinaryOperator::DIVIDE:
-                    chunk.write_opcode(OpCode::OP_DIVIDE);
+                    chunk.write_opcode(OpCode::OP_DIVIDE, line);
                     break;
                 case BinaryOperator::EQUAL:
-                    chunk.write_opcode(OpCode::OP_EQUAL);
+                    chunk.write_opcode(OpCode::OP_EQUAL, line);
                     break;
                 case BinaryOperator::NOT_EQUAL:
-                    chunk.write_opcode(OpCode::OP_NOT_EQUAL);
+                    chunk.write_opcode(OpCode::OP_NOT_EQUAL, line);
                     break;
                 case BinaryOperator::LESS_THAN:
-                    chunk.write_opcode(OpCode::OP_LESS);
+                    chunk.write_opcode(OpCode::OP_LESS, line);
                     break;
                 case BinaryOperator::LESS_EQUAL:
-                    chunk.write_opcode(OpCode::OP_LESS_EQUAL);
+                    chunk.write_opcode(OpCode::OP_LESS_EQUAL, line);
                     break;
                 case BinaryOperator::GREATER_THAN:
-                    chunk.write_opcode(OpCode::OP_GREATER);
+                    chunk.write_opcode(OpCode::OP_GREATER, line);
                     break;
                 case BinaryOperator::GREATER_EQUAL:
-                    chunk.write_opcode(OpCode::OP_GREATER_EQUAL);
+                    chunk.write_opcode(OpCode::OP_GREATER_EQUAL, line);
                     break;
                 default:
                     compile_error("Unsupported binary operator");
@@ -157,12 +266,80 @@ CompileResult Compiler::compile_expression(const Expression& expr, Chunk& chunk)
             return CompileResult::OK;
         }
         
+        case ASTNodeType::ERROR_EXPRESSION:
+            compile_error("Cannot compile an expression with syntax errors");
+            return CompileResult::ERROR;
+        
         default:
             compile_error("Unsupported expression type");
             return CompileResult::ERROR;
     }
 }
 
+CompileResult Compiler::integer_literal_value(const IntegerLiteral& literal, int32_t& value) {
+    // The lexer already decoded the literal in its base; it only has to fit in 32 bits
+    if (literal.number > static_cast<uint64_t>(INT32_MAX)) {
+        compile_error("Invalid integer literal: " + literal.value);
+        return CompileResult::ERROR;
+    }
+    value = static_cast<int32_t>(literal.number);
+    return CompileResult::OK;
+}
+
+CompileResult Compiler::make_constant(const Value& value, Chunk& chunk, uint8_t& index) {
+    size_t const_idx = chunk.add_constant(value);
+    
+    // Check if constant index fits in a byte
+    if (const_idx > 255) {
+        compile_error("Too many constants");
+        return CompileResult::ERROR;
+    }
+    
+    index = static_cast<uint8_t>(const_idx);
+    return CompileResult::OK;
+}
+
+const Compiler::Builtin* Compiler::find_builtin(std::string_view name) {
+    // Builtins compile to a single instruction operating on their arguments
+    static constexpr Builtin builtins[] = {
+        {"print", 1, OpCode::OP_PRINT},
+        {"read_line", 0, OpCode::OP_READ_LINE},
+        {"find", 2, OpCode::OP_FIND},
+        {"split", 3, OpCode::OP_SPLIT},
+        {"equals_ignore_case", 2, OpCode::OP_EQUALS_IGNORE_CASE},
+        {"is_utf8", 1, OpCode::OP_IS_UTF8},
+        {"count_lines", 1, OpCode::OP_COUNT_LINES},
+    };
+    for (const Builtin& builtin : builtins) {
+        if (builtin.name == name) {
+            return &builtin;
+        }
+    }
+    return nullptr;
+}
+
+OpCode Compiler::select_superinstruction(const BinaryExpression& expr) const {
+    if (!config_.profile || expr.right->type != ASTNodeType::INTEGER_LITERAL) {
+        return OpCode::OP_CONSTANT;
+    }
+    
+    // Only fuse operators the profile saw executing on integers alone. Samples of the
+    // fused opcode count too, so re-profiling a fused build keeps the same selection.
+    auto fuse_if_integer_only = [&](OpCode plain, OpCode fused) {
+        return config_.profile->is_integer_only(plain, fused) ? fused : OpCode::OP_CONSTANT;
+    };
+    switch (expr.operator_) {
+        case BinaryOperator::ADD:
+            return fuse_if_integer_only(OpCode::OP_ADD, OpCode::OP_ADD_CONSTANT);
+        case BinaryOperator::SUBTRACT:
+            return fuse_if_integer_only(OpCode::OP_SUBTRACT, OpCode::OP_SUBTRACT_CONSTANT);
+        case BinaryOperator::MULTIPLY:
+            return fuse_if_integer_only(OpCode::OP_MULTIPLY, OpCode::OP_MULTIPLY_CONSTANT);
+        default:
+            return OpCode::OP_CONSTANT;
+    }
+}
+
 void Compiler::compile_error(const std::string& message) {
     error_message_ = message;
     if (config_.debug_mode) {
@@ -170,7 +347,7 @@ void Compiler::compile_error(const std::string& message) {
     }
 }
 
-void Compiler::debug_print(const std::string& message) const {
+void Compiler::debug_print(std::string_view message) const {
     if (config_.debug_mode) {
         std::cout << "[Compiler] " << message << std::endl;
     }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include "ast.h"
 #include "chunk.h"
 #include "value.h"
+#include "profile.h"
+#include "metrics.h"
 
 namespace dacite {
 
@@ -16,6 +19,8 @@ enum class CompileResult {
 /// Configuration for the compiler
 struct CompilerConfig {
     bool debug_mode = false;
+    const Profile* profile = nullptr;  // Execution profile used to select superinstructions
+    Metrics* metrics = nullptr;        // Record compile timings when set
 };
 
 /// Compiler that converts AST to bytecode
@@ -27,6 +32,9 @@ public:
     /// Compile a program AST to bytecode
     CompileResult compile(const Program& program, Chunk& chunk);
     
+    /// Compile a single expression to bytecode that returns its value
+    CompileResult compile_standalone_expression(const Expression& expr, Chunk& chunk);
+    
     /// Get any compilation error message
     const std::string& get_error_message() const { return error_message_; }
     
@@ -42,11 +50,26 @@ private:
     CompileResult compile_statement(const Statement& stmt, Chunk& chunk);
     CompileResult compile_expression(const Expression& expr, Chunk& chunk);
     
+    // Constant pool helpers
+    CompileResult integer_literal_value(const IntegerLiteral& literal, int32_t& value);
+    CompileResult make_constant(const Value& value, Chunk& chunk, uint8_t& index);
+    
+    // Builtin functions
+    struct Builtin {
+        std::string_view name;
+        size_t arity;
+        OpCode opcode;
+    };
+    static const Builtin* find_builtin(std::string_view name);
+    
+    // Profile-guided superinstruction selection
+    OpCode select_superinstruction(const BinaryExpression& expr) const;
+    
     // Error handling
     void compile_error(const std::string& message);
     
     // Debug output
-    void debug_print(const std::string& message) const;
+    void debug_print(std::string_view message) const;
 };
 
 } // namespace dacite
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "json.h"
+#include <charconv>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+
+namespace dacite {
+
+namespace {
+
+constexpr size_t MAX_DEPTH = 256;
+
+void dump_string(std::string& out, std::string_view value) {
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void append_utf8(std::string& out, uint32_t code_point) {
+    if (code_point < 0x80) {
+        out += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        out += static_cast<char>(0xC0 | (code_point >> 6));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        out += static_cast<char>(0xE0 | (code_point >> 12));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code_point >> 18));
+        out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
+
+/// Recursive descent JSON reader
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : text_(text), pos_(0) {}
+
+    std::optional<Json> read_document() {
+        auto value = read_value(0);
+        skip_whitespace();
+        if (!value || pos_ != text_.size()) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+private:
+    std::string_view text_;
+    size_t pos_;
+
+    void skip_whitespace() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            pos_++;
+        }
+    }
+
+    bool consume(char expected) {
+        skip_whitespace();
+        if (pos_ < text_.size() && text_[pos_] == expected) {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consume_literal(std::string_view literal) {
+        if (text_.substr(pos_, literal.size()) != literal) {
+            return false;
+        }
+        pos_ += literal.size();
+        return true;
+    }
+
+    std::optional<Json> read_value(size_t depth) {
+        if (depth > MAX_DEPTH) {
+            return std::nullopt;
+        }
+        skip_whitespace();
+        if (pos_ >= text_.size()) {
+            return std::nullopt;
+        }
+
+        switch (text_[pos_]) {
+            case '{': return read_object(depth);
+            case '[': return read_array(depth);
+            case '"': {
+                auto value = read_string();
+                if (!value) return std::nullopt;
+                return Json(std::move(*value));
+            }
+            case 't': if (consume_literal("true")) return Json(true); return std::nullopt;
+            case 'f': if (consume_literal("false")) return Json(false); return std::nullopt;
+            case 'n': if (consume_literal("null")) return Json(); return std::nullopt;
+            default: return read_number();
+        }
+    }
+
+    std::optional<Json> read_number() {
+        size_t start = pos_;
+        while (pos_ < text_.size() &&
+               (std::isdigit(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '-' ||
+                text_[pos_] == '+' || text_[pos_] == '.' || text_[pos_] == 'e' || text_[pos_] == 'E')) {
+            pos_++;
+        }
+        double value;
+        auto [end, error] = std::from_chars(text_.data() + start, text_.data() + pos_, value);
+        if (start == pos_ || error != std::errc() || end != text_.data() + pos_) {
+            return std::nullopt;
+        }
+        return Json(value);
+    }
+
+    std::optional<uint32_t> read_hex4() {
+        if (pos_ + 4 > text_.size()) {
+            return std::nullopt;
+        }
+        uint32_t value = 0;
+        auto [end, error] = std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, value, 16);
+        if (error != std::errc() || end != text_.data() + pos_ + 4) {
+            return std::nullopt;
+        }
+        pos_ += 4;
+        return value;
+    }
+
+    std::optional<std::string> read_string() {
+        pos_++; // Skip opening quote
+        std::string result;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c != '\\') {
+                result += c;
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                return std::nullopt;
+            }
+            switch (text_[pos_++]) {
+                case '"':  result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/':  result += '/'; break;
+                case 'b':  result += '\b'; break;
+                case 'f':  result += '\f'; break;
+                case 'n':  result += '\n'; break;
+                case 'r':  result += '\r'; break;
+                case 't':  result += '\t'; break;
+                case 'u': {
+                    auto code_point = read_hex4();
+                    if (!code_point) return std::nullopt;
+                    // Combine UTF-16 surrogate pairs
+                    if (*code_point >= 0xD800 && *code_point <= 0xDBFF && consume_literal("\\u")) {
+                        auto low = read_hex4();
+                        if (!low || *low < 0xDC00 || *low > 0xDFFF) return std::nullopt;
+                        *code_point = 0x10000 + ((*code_point - 0xD800) << 10) + (*low - 0xDC00);
+                    }
+                    append_utf8(result, *code_point);
+                    break;
+                }
+                default:
+                    return std::nullopt;
+            }
+        }
+        if (pos_ >= text_.size()) {
+            return std::nullopt;
+        }
+        pos_++; // Skip closing quote
+        return result;
+    }
+
+    std::optional<Json> read_array(size_t depth) {
+        pos_++; // Skip '['
+        Json::Array array;
+        if (consume(']')) {
+            return Json(std::move(array));
+        }
+        do {
+            auto value = read_value(depth + 1);
+            if (!value) return std::nullopt;
+            array.push_back(std::move(*value));
+        } while (consume(','));
+        if (!consume(']')) {
+            return std::nullopt;
+        }
+        return Json(std::move(array));
+    }
+
+    std::optional<Json> read_object(size_t depth) {
+        pos_++; // Skip '{'
+        Json::Object object;
+        if (consume('}')) {
+            return Json(std::move(object));
+        }
+        do {
+            skip_whitespace();
+            if (pos_ >= text_.size() || text_[pos_] != '"') return std::nullopt;
+            auto key = read_string();
+            if (!key || !consume(':')) return std::nullopt;
+            auto value = read_value(depth + 1);
+            if (!value) return std::nullopt;
+            object.emplace_back(std::move(*key), std::move(*value));
+        } while (consume(','));
+        if (!consume('}')) {
+            return std::nullopt;
+        }
+        return Json(std::move(object));
+    }
+};
+
+} // namespace
+
+const Json* Json::get(std::string_view key) const {
+    if (!is_object()) {
+        return nullptr;
+    }
+    for (const auto& [name, value] : as_object()) {
+        if (name == key) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+const Json* Json::get_path(std::initializer_list<std::string_view> path) const {
+    const Json* current = this;
+    for (auto key : path) {
+        current = current->get(key);
+        if (!current) {
+            return nullptr;
+        }
+    }
+    return current;
+}
+
+std::string Json::dump() const {
+    std::string out;
+    dump_to(out);
+    return out;
+}
+
+void Json::dump_to(std::string& out) const {
+    if (is_null()) {
+        out += "null";
+    } else if (is_bool()) {
+        out += as_bool() ? "true" : "false";
+    } else if (is_number()) {
+        double value = as_number();
+        if (!std::isfinite(value)) {
+            out += "null";
+        } else if (value == std::floor(value) && std::fabs(value) < 9007199254740992.0) {
+            out += std::to_string(static_cast<int64_t>(value));
+        } else {
+            // Shortest representation that round-trips
+            char buffer[32];
+            auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, end);
+        }
+    } else if (is_string()) {
+        dump_string(out, as_string());
+    } else if (is_array()) {
+        out += '[';
+        const auto& array = as_array();
+        for (size_t i = 0; i < array.size(); ++i) {
+            if (i > 0) out += ',';
+            array[i].dump_to(out);
+        }
+        out += ']';
+    } else {
+        out += '{';
+        const auto& object = as_object();
+        for (size_t i = 0; i < object.size(); ++i) {
+            if (i > 0) out += ',';
+            dump_string(out, object[i].first);
+            out += ':';
+            object[i].second.dump_to(out);
+        }
+        out += '}';
+    }
+}
+
+std::optional<Json> Json::parse(std::string_view text) {
+    return JsonReader(text).read_document();
+}
+
+} // namespace dacite
\ No newline at end of file
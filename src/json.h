@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace dacite {
+
+/// Minimal JSON document model used by the tooling (language server, benchmarks)
+class Json {
+public:
+    using Array = std::vector<Json>;
+    using Object = std::vector<std::pair<std::string, Json>>;  // Keeps insertion order
+
+    /// Default constructor creates null
+    Json() : data_(std::monostate{}) {}
+    Json(std::nullptr_t) : data_(std::monostate{}) {}
+    Json(bool value) : data_(value) {}
+    Json(double value) : data_(value) {}
+    Json(int value) : data_(static_cast<double>(value)) {}
+    Json(int64_t value) : data_(static_cast<double>(value)) {}
+    Json(size_t value) : data_(static_cast<double>(value)) {}
+    Json(std::string value) : data_(std::move(value)) {}
+    Json(std::string_view value) : data_(std::string(value)) {}
+    Json(const char* value) : data_(std::string(value)) {}
+    Json(Array value) : data_(std::move(value)) {}
+    Json(Object value) : data_(std::move(value)) {}
+
+    /// Type checks
+    bool is_null() const { return std::holds_alternative<std::monostate>(data_); }
+    bool is_bool() const { return std::holds_alternative<bool>(data_); }
+    bool is_number() const { return std::holds_alternative<double>(data_); }
+    bool is_string() const { return std::holds_alternative<std::string>(data_); }
+    bool is_array() const { return std::holds_alternative<Array>(data_); }
+    bool is_object() const { return std::holds_alternative<Object>(data_); }
+
+    /// Accessors (throw std::bad_variant_access on type mismatch)
+    bool as_bool() const { return std::get<bool>(data_); }
+    double as_number() const { return std::get<double>(data_); }
+    const std::string& as_string() const { return std::get<std::string>(data_); }
+    const Array& as_array() const { return std::get<Array>(data_); }
+    const Object& as_object() const { return std::get<Object>(data_); }
+
+    /// Look up an object member, returns nullptr if missing or not an object
+    const Json* get(std::string_view key) const;
+
+    /// Follow a path of object members, returns nullptr if any step is missing
+    const Json* get_path(std::initializer_list<std::string_view> path) const;
+
+    /// Serialize to compact JSON text
+    std::string dump() const;
+
+    /// Parse JSON text, returns std::nullopt on malformed input
+    static std::optional<Json> parse(std::string_view text);
+
+    bool operator==(const Json& other) const { return data_ == other.data_; }
+
+private:
+    std::variant<std::monostate, bool, double, std::string, Array, Object> data_;
+
+    void dump_to(std::string& out) const;
+};
+
+} // namespace dacite
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "language_server.h"
+#include <algorithm>
+#include <cmath>
+#include "lexer.h"
+#include "string_kernels.h"
+#include "parser.h"
+
+namespace dacite {
+
+namespace {
+
+// JSON-RPC error codes
+constexpr int PARSE_ERROR = -32700;
+constexpr int INVALID_REQUEST = -32600;
+constexpr int METHOD_NOT_FOUND = -32601;
+constexpr int INVALID_PARAMS = -32602;
+
+// LSP constants
+constexpr int DIAGNOSTIC_SEVERITY_ERROR = 1;
+constexpr int SYMBOL_KIND_FUNCTION = 12;
+constexpr int TEXT_DOCUMENT_SYNC_FULL = 1;
+constexpr double MAX_UINTEGER = 2147483647.0;
+
+// Number of UTF-16 code units encoding the UTF-8 `text`
+size_t utf16_length(std::string_view text) {
+    size_t units = 0;
+    for (unsigned char byte : text) {
+        if ((byte & 0xC0) != 0x80) {
+            units += byte >= 0xF0 ? 2 : 1;
+        }
+    }
+    return units;
+}
+
+// Our columns count code points; LSP characters count UTF-16 units unless
+// the client accepted UTF-32, which counts code points as well
+Json make_position(std::string_view text, const SourcePosition& position, bool utf16) {
+    // LSP positions are 0-based, ours are 1-based
+    size_t character = position.column > 0 ? position.column - 1 : 0;
+    if (utf16 && position.offset <= text.size()) {
+        size_t newline = position.offset > 0 ? text.rfind('\n', position.offset - 1) : std::string_view::npos;
+        size_t line_start = newline == std::string_view::npos ? 0 : newline + 1;
+        character = utf16_length(text.substr(line_start, position.offset - line_start));
+    }
+    return Json::Object{
+        {"line", position.line > 0 ? position.line - 1 : 0},
+        {"character", character},
+    };
+}
+
+Json make_range(std::string_view text, const SourceSpan& span, bool utf16) {
+    return Json::Object{{"start", make_position(text, span.start, utf16)}, {"end", make_position(text, span.end, utf16)}};
+}
+
+Json make_location(std::string_view text, const SymbolLocation& location, bool utf16) {
+    return Json::Object{{"uri", location.uri}, {"range", make_range(text, location.span, utf16)}};
+}
+
+std::string make_response(const Json& id, Json result) {
+    return Json(Json::Object{{"jsonrpc", "2.0"}, {"id", id}, {"result", std::move(result)}}).dump();
+}
+
+std::string make_error(const Json& id, int code, std::string message) {
+    return Json(Json::Object{
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"error", Json::Object{{"code", code}, {"message", std::move(message)}}},
+    }).dump();
+}
+
+std::string make_notification(std::string method, Json params) {
+    return Json(Json::Object{{"jsonrpc", "2.0"}, {"method", std::move(method)}, {"params", std::move(params)}}).dump();
+}
+
+Json make_diagnostic(std::string_view text, const SourceSpan& span, const std::string& message,
+                     const char* source, bool utf16) {
+    return Json::Object{
+        {"range", make_range(text, span, utf16)},
+        {"severity", DIAGNOSTIC_SEVERITY_ERROR},
+        {"source", source},
+        {"message", message},
+    };
+}
+
+const std::string* get_string(const Json& json, std::initializer_list<std::string_view> path) {
+    const Json* value = json.get_path(path);
+    return value && value->is_string() ? &value->as_string() : nullptr;
+}
+
+// A position field: an LSP uinteger, so a non-negative integer below 2^31
+std::optional<size_t> get_uinteger(const Json& json, std::initializer_list<std::string_view> path) {
+    const Json* value = json.get_path(path);
+    if (!value || !value->is_number()) {
+        return std::nullopt;
+    }
+    double number = value->as_number();
+    if (!(number >= 0.0 && number <= MAX_UINTEGER) || std::floor(number) != number) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(number);
+}
+
+// Column (1-based, in code points) of the LSP `character` on the line
+// starting at `line_start`; a character past the end of the line clamps to it
+size_t column_at(std::string_view text, size_t line_start, size_t character) {
+    size_t column = 1;
+    size_t units = 0;
+    size_t i = line_start;
+    while (units < character && i < text.size() && text[i] != '\n') {
+        text::CodePoint code_point = text::decode_utf8(text, i);
+        size_t length = code_point.length > 0 ? code_point.length : 1;
+        units += code_point.length > 0 && code_point.value >= 0x10000 ? 2 : 1;
+        i += length;
+        column++;
+    }
+    return column;
+}
+
+bool is_before(const SourcePosition& a, size_t line, size_t column) {
+    return a.line < line || (a.line == line && a.column <= column);
+}
+
+} // namespace
+
+std::vector<std::string> LanguageServer::handle(std::string_view message) {
+    auto parsed = Json::parse(message);
+    if (!parsed || !parsed->is_object()) {
+        return {make_error(Json(), PARSE_ERROR, "Invalid JSON-RPC message")};
+    }
+
+    const Json& request = *parsed;
+    const Json* id = request.get("id");
+    const std::string* method = get_string(request, {"method"});
+    const Json null_params;
+    const Json& params = request.get("params") ? *request.get("params") : null_params;
+
+    if (!method) {
+        // Responses to server-initiated requests are not used
+        if (id) return {make_error(*id, INVALID_REQUEST, "Missing method")};
+        return {};
+    }
+
+    if (*method == "exit") {
+        exit_requested_ = true;
+        return {};
+    }
+
+    // Notifications
+    if (!id) {
+        const std::string* uri = get_string(params, {"textDocument", "uri"});
+        if (*method == "textDocument/didOpen") {
+            const std::string* text = get_string(params, {"textDocument", "text"});
+            if (uri && text) return {update_document(*uri, *text)};
+        } else if (*method == "textDocument/didChange") {
+            // Full document sync: the last change holds the whole text
+            const Json* changes = params.get("contentChanges");
+            if (uri && changes && changes->is_array() && !changes->as_array().empty()) {
+                const std::string* text = get_string(changes->as_array().back(), {"text"});
+                if (text) return {update_document(*uri, *text)};
+            }
+        } else if (*method == "textDocument/didClose") {
+            if (uri) {
+                close_document(*uri);
+                return {make_notification("textDocument/publishDiagnostics",
+                                          Json::Object{{"uri", *uri}, {"diagnostics", Json::Array{}}})};
+            }
+        }
+        return {};
+    }
+
+    // Requests
+    if (*method == "initialize") {
+        return {make_response(*id, handle_initialize(params))};
+    }
+    if (*method == "shutdown") {
+        shutdown_requested_ = true;
+        return {make_response(*id, Json())};
+    }
+    if (*method == "textDocument/definition") {
+        const std::string* uri = get_string(params, {"textDocument", "uri"});
+        if (!uri) {
+            return {make_error(*id, INVALID_PARAMS, "Missing textDocument.uri")};
+        }
+        auto line = get_uinteger(params, {"position", "line"});
+        auto character = get_uinteger(params, {"position", "character"});
+        if (!line || !character) {
+            return {make_error(*id, INVALID_PARAMS, "Invalid position")};
+        }
+        return {make_response(*id, handle_definition(*uri, *line, *character))};
+    }
+    if (*method == "textDocument/documentSymbol") {
+        if (!get_string(params, {"textDocument", "uri"})) {
+            return {make_error(*id, INVALID_PARAMS, "Missing textDocument.uri")};
+        }
+        return {make_response(*id, handle_document_symbol(params))};
+    }
+    return {make_error(*id, METHOD_NOT_FOUND, "Method not found: " + *method)};
+}
+
+const std::vector<SymbolLocation>* LanguageServer::find_symbol(std::string_view name) const {
+    auto it = index_.find(std::string(name));
+    if (it == index_.end() || it->second.empty()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+Json LanguageServer::handle_initialize(const Json& params) {
+    // UTF-16 is the protocol default; take UTF-32 when offered since it matches our columns
+    utf16_ = true;
+    const Json* encodings = params.get_path({"capabilities", "general", "positionEncodings"});
+    if (encodings && encodings->is_array()) {
+        for (const auto& encoding : encodings->as_array()) {
+            if (encoding.is_string() && encoding.as_string() == "utf-32") {
+                utf16_ = false;
+            }
+        }
+    }
+    return Json::Object{
+        {"capabilities", Json::Object{
+            {"positionEncoding", utf16_ ? "utf-16" : "utf-32"},
+            {"textDocumentSync", TEXT_DOCUMENT_SYNC_FULL},
+            {"definitionProvider", true},
+            {"documentSymbolProvider", true},
+        }},
+        {"serverInfo", Json::Object{{"name", "dacite-lsp"}}},
+    };
+}
+
+Json LanguageServer::handle_definition(const std::string& uri, size_t line, size_t character) const {
+    auto document = documents_.find(uri);
+    if (document == documents_.end()) {
+        return Json();
+    }
+
+    // Find the token under the cursor (tokens are ordered by start position)
+    size_t target_line = line + 1;
+    size_t target_column = character + 1;
+    if (utf16_) {
+        const std::string& text = document->second.text;
+        size_t line_start = 0;
+        for (size_t i = 0; i < line; ++i) {
+            line_start = text.find('\n', line_start);
+            if (line_start == std::string::npos) {
+                return Json();
+            }
+            line_start++;
+        }
+        target_column = column_at(text, line_start, character);
+    }
+    const auto& tokens = document->second.tokens;
+    auto it = std::partition_point(tokens.begin(), tokens.end(), [&](const Token& token) {
+        return is_before(token.span.start, target_line, target_column);
+    });
+    if (it == tokens.begin()) {
+        return Json();
+    }
+    const Token& token = *std::prev(it);
+    bool inside = token.span.end.line > target_line ||
+                  (token.span.end.line == target_line && token.span.end.column > target_column);
+    if (token.type != TokenType::IDENTIFIER || !inside) {
+        return Json();
+    }
+
+    const auto* locations = find_symbol(token.value);
+    if (!locations) {
+        return Json();
+    }
+    Json::Array result;
+    for (const auto& location : *locations) {
+        result.push_back(make_location(documents_.at(location.uri).text, location, utf16_));
+    }
+    return result;
+}
+
+Json LanguageServer::handle_document_symbol(const Json& params) const {
+    const std::string* uri = get_string(params, {"textDocument", "uri"});
+    auto document = documents_.find(*uri);
+    if (document == documents_.end()) {
+        return Json();
+    }
+
+    Json::Array result;
+    for (const auto& name : document->second.symbols) {
+        for (const auto& location : index_.at(name)) {
+            if (location.uri != *uri) continue;
+            result.push_back(Json::Object{
+                {"name", name},
+                {"kind", SYMBOL_KIND_FUNCTION},
+                {"location", make_location(document->second.text, location, utf16_)},
+            });
+        }
+    }
+    return result;
+}
+
+std::string LanguageServer::update_document(const std::string& uri, std::string text) {
+    Document& document = documents_[uri];
+    document.text = std::move(text);
+    return analyze(uri, document);
+}
+
+void LanguageServer::close_document(const std::string& uri) {
+    auto it = documents_.find(uri);
+    if (it == documents_.end()) {
+        return;
+    }
+    remove_symbols(uri, it->second);
+    documents_.erase(it);
+}
+
+void LanguageServer::remove_symbols(const std::string& uri, const Document& document) {
+    for (const auto& name : document.symbols) {
+        auto it = index_.find(name);
+        if (it == index_.end()) continue;
+        std::erase_if(it->second, [&](const SymbolLocation& location) { return location.uri == uri; });
+        if (it->second.empty()) {
+            index_.erase(it);
+        }
+    }
+}
+
+std::string LanguageServer::analyze(const std::string& uri, Document& document) {
+    Json::Array diagnostics;
+
+    Lexer lexer(document.text);
+    document.tokens = lexer.tokenize_all();
+    for (const auto& error : lexer.get_errors()) {
+        diagnostics.push_back(make_diagnostic(document.text, error.span, error.message, "dacite-lexer", utf16_));
+    }
+
+    // Parse without error tokens so lexer errors don't cascade into parser errors
+    std::vector<Token> parser_tokens;
+    parser_tokens.reserve(document.tokens.size());
+    for (const auto& token : document.tokens) {
+        if (token.type != TokenType::ERROR) {
+            parser_tokens.push_back(token);
+        }
+    }
+    Parser parser(std::move(parser_tokens));
+    auto program = parser.parse();
+    for (const auto& error : parser.get_errors()) {
+        diagnostics.push_back(make_diagnostic(document.text, error.span, error.message, "dacite-parser", utf16_));
+    }
+
+    // Refresh this document's entries in the workspace index
+    remove_symbols(uri, document);
+    document.symbols.clear();
+    for (const auto& declaration : program->declarations) {
+        if (declaration->type != ASTNodeType::FUNCTION_DECLARATION) continue;
+        const auto& function = static_cast<const FunctionDeclaration&>(*declaration);
+        if (function.function_name.empty()) continue;
+        index_[function.function_name].push_back({uri, function.name_span});
+        if (std::find(document.symbols.begin(), document.symbols.end(), function.function_name) == document.symbols.end()) {
+            document.symbols.push_back(function.function_name);
+        }
+    }
+
+    return make_notification("textDocument/publishDiagnostics",
+                             Json::Object{{"uri", uri}, {"diagnostics", std::move(diagnostics)}});
+}
+
+} // namespace dacite
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "json.h"
+#include "token.h"
+
+namespace dacite {
+
+/// Location of a symbol definition in the workspace
+struct SymbolLocation {
+    std::string uri;
+    SourceSpan span;
+};
+
+/// Language Server Protocol implementation over JSON-RPC messages.
+/// Transport (Content-Length framing over stdio) is left to the caller.
+class LanguageServer {
+public:
+    /// Handle one JSON-RPC message and return the messages to send back
+    std::vector<std::string> handle(std::string_view message);
+    
+    /// Check if the client sent 'exit'
+    bool should_exit() const { return exit_requested_; }
+    
+    /// Process exit code required by the protocol (0 only after 'shutdown')
+    int exit_code() const { return shutdown_requested_ ? 0 : 1; }
+    
+    /// Look up all definitions of a symbol across open documents
+    const std::vector<SymbolLocation>* find_symbol(std::string_view name) const;
+    
+    /// Get the number of open documents
+    size_t get_document_count() const { return documents_.size(); }
+
+private:
+    /// State of one open document
+    struct Document {
+        std::string text;
+        std::vector<Token> tokens;
+        std::vector<std::string> symbols;   // Names this document contributes to the index
+    };
+    
+    std::unordered_map<std::string, Document> documents_;
+    std::unordered_map<std::string, std::vector<SymbolLocation>> index_;
+    bool shutdown_requested_ = false;
+    bool exit_requested_ = false;
+    bool utf16_ = true;   // Position characters count UTF-16 units rather than code points
+    
+    // Request handlers
+    Json handle_initialize(const Json& params);
+    Json handle_definition(const std::string& uri, size_t line, size_t character) const;
+    Json handle_document_symbol(const Json& params) const;
+    
+    // Document management
+    std::string update_document(const std::string& uri, std::string text);
+    void close_document(const std::string& uri);
+    void remove_symbols(const std::string& uri, const Document& document);
+    
+    // Analysis: re-lex and re-parse one document, refresh its index entries
+    // and return its publishDiagnostics notification
+    std::string analyze(const std::string& uri, Document& document);
+};
+
+} // namespace dacite
\ No newline at end of file
@@ -1,12 +1,64 @@
 #include "lexer.h"
+#include "string_kernels.h"
+#include "unicode.h"
 #include <iostream>
 #include <sstream>
-#include <cctype>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
 
 namespace dacite {
 
+namespace {
+
+/// Value of eight ASCII decimal digits, most significant first.
+///
+/// Loads them as one word and combines neighbours in three multiplies:
+/// digit pairs, then pairs of pairs, then the two four-digit halves.
+uint32_t parse_eight_digits(const char* digits) {
+    uint64_t chunk;
+    std::memcpy(&chunk, digits, sizeof(chunk));
+    if constexpr (std::endian::native == std::endian::big) {
+        chunk = std::byteswap(chunk);
+    }
+    chunk = ((chunk & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+    return static_cast<uint32_t>(((chunk & 0x0000FFFF0000FFFF) * 42949672960001) >> 32);
+}
+
+unsigned digit_value(char c) {
+    return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+}
+
+/// Decode `digits` (already checked for `base`) into `value`; false if it does not fit in 64 bits
+bool decode_integer(std::string_view digits, unsigned base, uint64_t& value) {
+    value = 0;
+    size_t i = 0;
+    if (base == 10) {
+        // Long decimal literals take eight digits per step
+        for (; i + 8 <= digits.size(); i += 8) {
+            if (__builtin_mul_overflow(value, uint64_t{100000000}, &value) ||
+                __builtin_add_overflow(value, parse_eight_digits(digits.data() + i), &value)) {
+                return false;
+            }
+        }
+    }
+    for (; i < digits.size(); ++i) {
+        if (__builtin_mul_overflow(value, uint64_t{base}, &value) ||
+            __builtin_add_overflow(value, uint64_t{digit_value(digits[i])}, &value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 Lexer::Lexer(std::string_view source, const LexerConfig& config)
-    : source_(source), current_pos_(0), current_position_(1, 1, 0), config_(config) {}
+    : source_(source), current_pos_(0), ascii_end_(text::ascii_prefix_length(source))
+    , current_position_(1, 1, 0), config_(config)
+    , errors_(config.memory_resource ? config.memory_resource : std::pmr::get_default_resource()) {}
 
 Token Lexer::next_token() {
     // If we have a peeked token, return it
@@ -48,6 +100,13 @@ Token Lexer::next_token() {
         if (config_.debug_mode) debug_print_token(token);
         return token;
     }
+    
+    // Decode only when the byte is not ASCII
+    if (static_cast<unsigned char>(c) >= 0x80) {
+        auto token = lex_non_ascii();
+        if (config_.debug_mode) debug_print_token(token);
+        return token;
+    }
 
     // Handle numbers
     if (is_digit(c)) {
@@ -108,14 +167,40 @@ bool Lexer::at_end() const {
 
 std::vector<Token> Lexer::tokenize_all() {
     std::vector<Token> tokens;
+    tokenize_all(tokens);
+    return tokens;
+}
+
+void Lexer::tokenize_all(std::vector<Token>& tokens) {
+    StageTimer timer(config_.metrics, Stage::LEX);
+    tokens.clear();
+    while (!at_end()) {
+        tokens.push_back(next_token());
+        if (tokens.back().type == TokenType::EOF_TOKEN) {
+            break;
+        }
+    }
+}
+
+void Lexer::tokenize_all(TokenBuffer& tokens) {
+    StageTimer timer(config_.metrics, Stage::LEX);
+    tokens.clear(source_);
     while (!at_end()) {
-        auto token = next_token();
+        Token token = next_token();
         tokens.push_back(token);
         if (token.type == TokenType::EOF_TOKEN) {
             break;
         }
     }
-    return tokens;
+}
+
+void Lexer::reset(std::string_view source) {
+    source_ = source;
+    current_pos_ = 0;
+    ascii_end_ = text::ascii_prefix_length(source);
+    current_position_ = SourcePosition(1, 1, 0);
+    errors_.clear();
+    peeked_token_.reset();
 }
 
 std::string Lexer::dump_tokens() {
@@ -149,10 +234,12 @@ char Lexer::peek_char(size_t offset) const {
 
 void Lexer::advance() {
     if (current_pos_ < source_.length()) {
-        if (source_[current_pos_] == '\n') {
+        unsigned char byte = static_cast<unsigned char>(source_[current_pos_]);
+        if (byte == '\n') {
             current_position_.line++;
             current_position_.column = 1;
-        } else {
+        } else if ((byte & 0xC0) != 0x80) {
+            // Columns count code points, so continuation bytes do not move them
             current_position_.column++;
         }
         current_pos_++;
@@ -161,9 +248,20 @@ void Lexer::advance() {
 }
 
 void Lexer::advance_n(size_t n) {
-    for (size_t i = 0; i < n && current_pos_ < source_.length(); ++i) {
-        advance();
+    // Move over the whole run at once: lines from its newlines, columns from the
+    // code points after the last one, which are just bytes inside the ASCII prefix
+    std::string_view run = source_.substr(current_pos_, n);
+    bool ascii = current_pos_ + run.size() <= ascii_end_;
+    size_t last_newline = run.rfind('\n');
+    if (last_newline == std::string_view::npos) {
+        current_position_.column += ascii ? run.size() : text::count_code_points(run);
+    } else {
+        std::string_view last_line = run.substr(last_newline + 1);
+        current_position_.line += text::count_byte(run, '\n');
+        current_position_.column = 1 + (ascii ? last_line.size() : text::count_code_points(last_line));
     }
+    current_pos_ += run.size();
+    current_position_.offset += run.size();
 }
 
 bool Lexer::match(char expected) {
@@ -204,63 +302,98 @@ Token Lexer::make_error_token(const std::string& message, const SourcePosition&
 
 Token Lexer::lex_identifier_or_keyword() {
     auto start_pos = get_current_position();
-    std::string identifier;
+    size_t start = current_pos_;
 
-    while (current_pos_ < source_.length() && (is_alnum(current_char()) || current_char() == '_')) {
-        identifier += current_char();
-        advance();
+    while (current_pos_ < source_.length()) {
+        char c = current_char();
+        if (is_alnum(c) || c == '_') {
+            advance();
+            continue;
+        }
+        if (static_cast<unsigned char>(c) < 0x80) {
+            break;
+        }
+        auto code_point = text::decode_utf8(source_, current_pos_);
+        if (code_point.length == 0 || !unicode::is_xid_continue(code_point.value)) {
+            break;
+        }
+        advance_n(code_point.length);
     }
 
+    std::string identifier(source_.substr(start, current_pos_ - start));
     TokenType type = keyword_or_identifier(identifier);
     return make_token(type, std::move(identifier), start_pos);
 }
 
+Token Lexer::lex_non_ascii() {
+    auto start_pos = get_current_position();
+    auto code_point = text::decode_utf8(source_, current_pos_);
+    if (code_point.length == 0) {
+        advance();
+        return make_error_token("Invalid UTF-8 in source", start_pos);
+    }
+    if (unicode::is_xid_start(code_point.value)) {
+        return lex_identifier_or_keyword();
+    }
+    
+    std::string character(source_.substr(current_pos_, code_point.length));
+    advance_n(code_point.length);
+    return make_error_token("Unexpected character '" + character + "'", start_pos);
+}
+
 Token Lexer::lex_number() {
     auto start_pos = get_current_position();
-    std::string number;
+    size_t start = current_pos_;
+    size_t digits_start = start;
+    unsigned base = 10;
 
     // Handle different number formats
-    if (current_char() == '0' && peek_char() == 'x') {
-        // Hexadecimal
-        number += current_char(); advance();
-        number += current_char(); advance();
-        while (current_pos_ < source_.length() && is_hex_digit(current_char())) {
-            number += current_char();
+    if (current_char() == '0' && (peek_char() == 'x' || peek_char() == 'b')) {
+        // Hexadecimal or binary
+        base = peek_char() == 'x' ? 16 : 2;
+        advance_n(2);
+        digits_start = current_pos_;
+        while (current_pos_ < source_.length() &&
+               (base == 16 ? is_hex_digit(current_char()) : current_char() == '0' || current_char() == '1')) {
             advance();
         }
-    } else if (current_char() == '0' && peek_char() == 'b') {
-        // Binary
-        number += current_char(); advance();
-        number += current_char(); advance();
-        while (current_pos_ < source_.length() && (current_char() == '0' || current_char() == '1')) {
-            number += current_char();
-            advance();
+        if (current_pos_ == digits_start) {
+            return make_error_token(base == 16 ? "Expected hexadecimal digits after '0x'"
+                                               : "Expected binary digits after '0b'", start_pos);
         }
     } else if (current_char() == '0' && is_digit(peek_char())) {
         // Octal
+        base = 8;
         while (current_pos_ < source_.length() && is_digit(current_char()) && current_char() < '8') {
-            number += current_char();
             advance();
         }
     } else {
         // Decimal
         while (current_pos_ < source_.length() && is_digit(current_char())) {
-            number += current_char();
             advance();
         }
 
         // Check for decimal point
         if (current_char() == '.' && is_digit(peek_char())) {
-            number += current_char(); advance();
+            advance();
             while (current_pos_ < source_.length() && is_digit(current_char())) {
-                number += current_char();
                 advance();
             }
-            return make_token(TokenType::FLOAT_LITERAL, std::move(number), start_pos);
+            std::string_view lexeme = source_.substr(start, current_pos_ - start);
+            double value;
+            if (std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value).ec != std::errc()) {
+                return make_error_token("Float literal out of range", start_pos);
+            }
+            return Token(TokenType::FLOAT_LITERAL, std::string(lexeme), make_span(start_pos), std::bit_cast<uint64_t>(value));
         }
     }
 
-    return make_token(TokenType::INTEGER_LITERAL, std::move(number), start_pos);
+    std::string_view lexeme = source_.substr(start, current_pos_ - start);
+    uint64_t value;
+    if (!decode_integer(lexeme.substr(digits_start - start), base, value)) {
+        return make_error_token("Integer literal too large", start_pos);
+    }
+    return Token(TokenType::INTEGER_LITERAL, std::string(lexeme), make_span(start_pos), value);
 }
 
 Token Lexer::lex_string_literal() {
@@ -289,7 +422,15 @@ Token Lexer::lex_string_literal() {
                     return make_error_token("Invalid escape sequence", start_pos);
             }
         } else {
-            literal += current_char();
+            // Copy the run up to the next quote or escape at once, checking it is UTF-8
+            size_t run_end = std::min(source_.find_first_of("\"\\", current_pos_), source_.length());
+            std::string_view run = source_.substr(current_pos_, run_end - current_pos_);
+            if (!text::is_valid_utf8(run)) {
+                return make_error_token("Invalid UTF-8 in string literal", start_pos);
+            }
+            literal += run;
+            advance_n(run.size());
+            continue;
         }
         advance();
     }
@@ -345,38 +486,35 @@ Token Lexer::lex_char_literal() {
 
 Token Lexer::lex_single_line_comment() {
     auto start_pos = get_current_position();
-    std::string comment;
+    size_t end = std::min(source_.find('\n', current_pos_), source_.length());
+    std::string_view comment = source_.substr(current_pos_, end - current_pos_);
+    advance_n(comment.size());
 
-    while (current_pos_ < source_.length() && current_char() != '\n') {
-        comment += current_char();
-        advance();
+    if (!text::is_valid_utf8(comment)) {
+        return make_error_token("Invalid UTF-8 in comment", start_pos);
     }
-
-    return make_token(TokenType::SINGLE_LINE_COMMENT, std::move(comment), start_pos);
+    return make_token(TokenType::SINGLE_LINE_COMMENT, std::string(comment), start_pos);
 }
 
 Token Lexer::lex_multi_line_comment() {
     auto start_pos = get_current_position();
-    std::string comment;
 
     advance(); // Skip '/'
     advance(); // Skip '*'
 
-    while (current_pos_ < source_.length()) {
-        if (current_char() == '*' && peek_char() == '/') {
-            comment += current_char(); advance();
-            comment += current_char(); advance();
-            break;
-        }
-        comment += current_char();
-        advance();
-    }
-
-    if (current_pos_ >= source_.length()) {
+    // The comment text keeps its closing "*/"
+    size_t close = source_.find("*/", current_pos_);
+    if (close == std::string_view::npos) {
+        advance_n(source_.length() - current_pos_);
         return make_error_token("Unterminated multi-line comment", start_pos);
     }
+    std::string_view comment = source_.substr(current_pos_, close + 2 - current_pos_);
+    advance_n(comment.size());
 
-    return make_token(TokenType::MULTI_LINE_COMMENT, std::move(comment), start_pos);
+    if (!text::is_valid_utf8(comment)) {
+        return make_error_token("Invalid UTF-8 in comment", start_pos);
+    }
+    return make_token(TokenType::MULTI_LINE_COMMENT, std::string(comment), start_pos);
 }
 
 Token Lexer::lex_operator_or_punctuation() {
@@ -457,20 +595,22 @@ Token Lexer::lex_operator_or_punctuation() {
     }
 }
 
+// ASCII only; <cctype> depends on the locale and is undefined for negative chars
+
 bool Lexer::is_alpha(char c) const {
-    return std::isalpha(c) || c == '_';
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
 }
 
 bool Lexer::is_digit(char c) const {
-    return std::isdigit(c);
+    return c >= '0' && c <= '9';
 }
 
 bool Lexer::is_hex_digit(char c) const {
-    return std::isxdigit(c);
+    return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
 }
 
 bool Lexer::is_alnum(char c) const {
-    return std::isalnum(c);
+    return is_alpha(c) || is_digit(c);
 }
 
 bool Lexer::is_whitespace(char c) const {
@@ -4,8 +4,11 @@
 #include <string_view>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <functional>
 #include "token.h"
+#include "token_buffer.h"
+#include "metrics.h"
 
 namespace dacite {
 
@@ -15,6 +18,8 @@ struct LexerConfig {
     bool emit_whitespace = false;    // Include whitespace tokens in output
     bool debug_mode = false;         // Print tokens as they are lexed
     bool verbose_mode = false;       // Include extra debug information
+    Metrics* metrics = nullptr;      // Record tokenize_all timings when set
+    std::pmr::memory_resource* memory_resource = nullptr; // Allocate the error list from this when set
 };
 
 /// Error information for lexer errors
@@ -44,8 +49,17 @@ public:
     /// Get all tokens from the input (useful for debugging)
     std::vector<Token> tokenize_all();
 
+    /// Get all tokens into a caller-owned buffer (cleared first) so its capacity is reused
+    void tokenize_all(std::vector<Token>& tokens);
+
+    /// Get all tokens into a struct-of-arrays buffer over this lexer's source
+    void tokenize_all(TokenBuffer& tokens);
+
+    /// Restart on new source, keeping the error list's capacity
+    void reset(std::string_view source);
+
     /// Get any errors that occurred during lexing
-    const std::vector<LexerError>& get_errors() const { return errors_; }
+    const std::pmr::vector<LexerError>& get_errors() const { return errors_; }
 
     /// Check if any errors occurred
     bool has_errors() const { return !errors_.empty(); }
@@ -56,9 +70,10 @@ public:
 private:
     std::string_view source_;
     size_t current_pos_;
+    size_t ascii_end_;              // End of the source's ASCII prefix, where columns are byte counts
     SourcePosition current_position_;
     LexerConfig config_;
-    std::vector<LexerError> errors_;
+    std::pmr::vector<LexerError> errors_;
     std::unique_ptr<Token> peeked_token_;
 
     // Character manipulation
@@ -80,6 +95,7 @@ private:
 
     // Lexing methods
     Token lex_identifier_or_keyword();
+    Token lex_non_ascii();
     Token lex_number();
     Token lex_string_literal();
     Token lex_char_literal();
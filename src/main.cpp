@@ -1,93 +1,348 @@
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
 #include "lexer.h"
 #include "parser.h"
+#include "compiler.h"
+#include "vm.h"
+#include "profile.h"
+#include "repl.h"
+#include "alloc_tracker.h"
+
+namespace {
+
+/// Command line options
+struct Options {
+    std::optional<std::string> file;
+    bool dump_source = true;
+    bool dump_tokens = true;
+    bool dump_ast = true;
+    bool dump_bytecode = true;
+    bool time = false;
+    bool repl = false;
+    bool perf = false;
+    size_t repeat = 1;
+    std::optional<std::string> profile_in;
+    std::optional<std::string> profile_out;
+};
+
+/// Resources used by one pipeline stage in one iteration
+struct StageSample {
+    double wall_ms = 0.0;
+    dacite::AllocationStats allocations;
+    long process_peak_rss_kb = 0;  // Whole-process high-water mark once the stage ends, not the stage's own
+};
+
+constexpr const char* STAGE_NAMES[] = {"lex", "parse", "compile", "execute"};
+constexpr size_t STAGE_COUNT = 4;
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options] [file.dt]\n"
+              << "\n"
+              << "Runs the full pipeline (lex, parse, compile, execute) on a dacite file.\n"
+              << "\n"
+              << "Options:\n"
+              << "  --quiet              Suppress all dumps\n"
+              << "  --no-source          Do not print the source\n"
+              << "  --no-tokens          Do not print the token stream\n"
+              << "  --no-ast             Do not print the AST\n"
+              << "  --no-bytecode        Do not print the compiled chunk\n"
+              << "  --time               Report wall time, allocations and peak live heap per stage,\n"
+              << "                       and the process peak RSS reached by the end of each stage\n"
+              << "  --repeat N           Run the pipeline N times (dumps are printed once)\n"
+              << "  --profile-out FILE   Write the execution profile of the last run to FILE\n"
+              << "  --profile-in FILE    Compile with the execution profile in FILE\n"
+              << "  --perf               Name functions in /tmp/perf-<pid>.map and mark source lines for perf\n"
+              << "  --repl               Start an interactive session (--time reports per-input latency)\n"
+              << "  --help               Show this message\n";
+}
+
+long peak_rss_kb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/// Run one stage and record its wall time, allocations and the process peak RSS after it
+template <typename Fn>
+auto measure(StageSample& sample, Fn&& fn) {
+    dacite::AllocationScope scope;
+    auto start = std::chrono::steady_clock::now();
+
+    auto result = fn();
+
+    auto end = std::chrono::steady_clock::now();
+    sample.wall_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    sample.allocations = scope.stats();
+    sample.process_peak_rss_kb = peak_rss_kb();
+    return result;
+}
+
+void print_timing(const std::vector<std::array<StageSample, STAGE_COUNT>>& samples) {
+    std::cout << "=== TIMING (" << samples.size() << (samples.size() == 1 ? " run" : " runs") << ") ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "stage"
+              << std::right << std::setw(12) << "min ms"
+              << std::setw(12) << "median ms"
+              << std::setw(12) << "allocs"
+              << std::setw(14) << "bytes"
+              << std::setw(14) << "peak live"
+              << std::setw(22) << "process peak RSS KiB" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(4);
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+        std::vector<double> times;
+        for (const auto& iteration : samples) {
+            times.push_back(iteration[stage].wall_ms);
+        }
+        std::sort(times.begin(), times.end());
+
+        // Allocations and RSS are reported for the last (warmest) iteration
+        const auto& last = samples.back()[stage];
+        std::cout << std::left << std::setw(10) << STAGE_NAMES[stage]
+                  << std::right << std::setw(12) << times.front()
+                  << std::setw(12) << times[times.size() / 2]
+                  << std::setw(12) << last.allocations.allocations
+                  << std::setw(14) << last.allocations.bytes
+                  << std::setw(14) << last.allocations.peak_live_bytes
+                  << std::setw(22) << last.process_peak_rss_kb << std::endl;
+    }
+    std::cout << "(peak RSS is the process-wide ru_maxrss high-water mark at the end of each stage)" << std::endl;
+}
+
+int run_repl(const Options& options) {
+    dacite::Repl repl;
+    std::string line;
+    
+    std::cout << "dacite REPL - enter expressions or declarations, :quit to exit" << std::endl;
+    while (true) {
+        std::cout << "> " << std::flush;
+        if (!std::getline(std::cin, line) || line == ":quit" || line == ":q") {
+            break;
+        }
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        auto result = repl.eval(line);
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+        
+        if (!result.output.empty()) {
+            std::cout << result.output << std::endl;
+        }
+        if (options.time) {
+            std::cout << "(" << std::fixed << std::setprecision(1) << elapsed.count() << " us)" << std::endl;
+        }
+    }
+    return 0;
+}
+
+template <typename Errors>
+void print_errors(const char* title, const Errors& errors) {
+    std::cout << title << std::endl;
+    for (const auto& error : errors) {
+        std::cout << "Error at line " << error.span.start.line
+                  << ", column " << error.span.start.column
+                  << ": " << error.message << std::endl;
+    }
+}
+
+} // namespace
 
 int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "--quiet") {
+            options.dump_source = options.dump_tokens = options.dump_ast = options.dump_bytecode = false;
+        } else if (arg == "--no-source") {
+            options.dump_source = false;
+        } else if (arg == "--no-tokens") {
+            options.dump_tokens = false;
+        } else if (arg == "--no-ast") {
+            options.dump_ast = false;
+        } else if (arg == "--no-bytecode") {
+            options.dump_bytecode = false;
+        } else if (arg == "--time") {
+            options.time = true;
+        } else if (arg == "--repl") {
+            options.repl = true;
+        } else if (arg == "--perf") {
+            options.perf = true;
+        } else if ((arg == "--repeat" || arg == "--profile-in" || arg == "--profile-out") && i + 1 < argc) {
+            std::string value = argv[++i];
+            if (arg == "--repeat") {
+                try {
+                    options.repeat = std::stoul(value);
+                } catch (const std::exception&) {
+                    options.repeat = 0;
+                }
+                if (options.repeat == 0) {
+                    std::cerr << "Error: --repeat expects a positive number" << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--profile-in") {
+                options.profile_in = value;
+            } else {
+                options.profile_out = value;
+            }
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            options.file = arg;
+        }
+    }
+
+    if (options.repl) {
+        return run_repl(options);
+    }
+
     // Default test source code if no file is provided
     std::string source = R"(package main;
 
 fn main() i32 { return 5; })";
 
     // If a file is provided as argument, read it
-    if (argc > 1) {
-        std::ifstream file(argv[1]);
+    if (options.file) {
+        std::ifstream file(*options.file);
         if (file.is_open()) {
             source = std::string((std::istreambuf_iterator<char>(file)),
                                  std::istreambuf_iterator<char>());
             file.close();
-            std::cout << "Processing file: " << argv[1] << std::endl;
+            std::cout << "Processing file: " << *options.file << std::endl;
         } else {
-            std::cerr << "Error: Could not open file " << argv[1] << std::endl;
+            std::cerr << "Error: Could not open file " << *options.file << std::endl;
             return 1;
         }
     } else {
         std::cout << "Processing default source code:" << std::endl;
     }
 
-    std::cout << "Source:" << std::endl;
-    std::cout << source << std::endl;
-    std::cout << std::endl;
+    if (options.dump_source) {
+        std::cout << "Source:" << std::endl;
+        std::cout << source << std::endl;
+        std::cout << std::endl;
+    }
+
+    std::optional<dacite::Profile> input_profile;
+    if (options.profile_in) {
+        input_profile = dacite::Profile::load(*options.profile_in);
+        if (!input_profile) {
+            std::cerr << "Error: Could not read profile " << *options.profile_in << std::endl;
+            return 1;
+        }
+    }
 
-    // Create lexer with debug mode enabled
-    dacite::LexerConfig lexer_config;
-    lexer_config.debug_mode = false;
-    lexer_config.emit_comments = true;
+    std::optional<dacite::PerfMap> perf_map;
+    if (options.perf) {
+        perf_map.emplace();
+    }
 
-    dacite::Lexer lexer(source, lexer_config);
+    std::vector<std::array<StageSample, STAGE_COUNT>> samples;
+    dacite::Profile output_profile;
+    dacite::Value result;
 
-    std::cout << "=== LEXER OUTPUT ===" << std::endl;
-    
-    // Tokenize
-    auto tokens = lexer.tokenize_all();
-    
-    if (lexer.has_errors()) {
-        std::cout << "Lexer Errors:" << std::endl;
-        for (const auto& error : lexer.get_errors()) {
-            std::cout << "Error at line " << error.span.start.line 
-                      << ", column " << error.span.start.column 
-                      << ": " << error.message << std::endl;
+    for (size_t iteration = 0; iteration < options.repeat; ++iteration) {
+        bool first = iteration == 0;
+        output_profile = {}; // --profile-out keeps only the last run
+        auto& sample = samples.emplace_back();
+
+        // Lex
+        dacite::Lexer lexer(source);
+        auto tokens = measure(sample[0], [&] { return lexer.tokenize_all(); });
+
+        if (lexer.has_errors()) {
+            print_errors("Lexer Errors:", lexer.get_errors());
+            return 1;
         }
-        return 1;
-    }
 
-    std::cout << "Tokens:" << std::endl;
-    for (const auto& token : tokens) {
-        std::cout << "  [" << token.span.start.line << ":" << token.span.start.column << "] ";
-        std::cout << dacite::token_type_to_string(token.type);
-        if (!token.value.empty()) {
-            std::cout << "(\"" << token.value << "\")";
+        if (first && options.dump_tokens) {
+            std::cout << "=== LEXER OUTPUT ===" << std::endl;
+            std::cout << "Tokens:" << std::endl;
+            for (const auto& token : tokens) {
+                std::cout << "  [" << token.span.start.line << ":" << token.span.start.column << "] ";
+                std::cout << dacite::token_type_to_string(token.type);
+                if (!token.value.empty()) {
+                    std::cout << "(\"" << token.value << "\")";
+                }
+                std::cout << std::endl;
+            }
+            std::cout << std::endl;
         }
-        std::cout << std::endl;
-    }
-    std::cout << std::endl;
 
-    std::cout << "=== PARSER OUTPUT ===" << std::endl;
+        // Parse
+        dacite::Parser parser(std::move(tokens));
+        auto program = measure(sample[1], [&] { return parser.parse(); });
+
+        if (parser.has_errors()) {
+            print_errors("Parser Errors:", parser.get_errors());
+            return 1;
+        }
+
+        if (first && options.dump_ast && program) {
+            std::cout << "=== PARSER OUTPUT ===" << std::endl;
+            std::cout << "AST:" << std::endl;
+            std::cout << program->to_string() << std::endl;
+            std::cout << std::endl;
+        }
 
-    // Create parser
-    dacite::ParserConfig parser_config;
-    parser_config.debug_mode = false; // Set to true for detailed parsing steps
-    dacite::Parser parser(std::move(tokens), parser_config);
+        // Compile
+        dacite::CompilerConfig compiler_config;
+        compiler_config.profile = input_profile ? &*input_profile : nullptr;
+        dacite::Compiler compiler(compiler_config);
+        dacite::Chunk chunk;
+        auto compile_result = measure(sample[2], [&] { return compiler.compile(*program, chunk); });
 
-    // Parse
-    auto program = parser.parse();
+        if (compile_result != dacite::CompileResult::OK) {
+            std::cout << "Compile Error: " << compiler.get_error_message() << std::endl;
+            return 1;
+        }
 
-    if (parser.has_errors()) {
-        std::cout << "Parser Errors:" << std::endl;
-        for (const auto& error : parser.get_errors()) {
-            std::cout << "Error at line " << error.span.start.line
-                      << ", column " << error.span.start.column
-                      << ": " << error.message << std::endl;
+        if (first && options.dump_bytecode) {
+            std::cout << "=== COMPILER OUTPUT ===" << std::endl;
+            std::cout << chunk.to_string() << std::endl;
+            std::cout << std::endl;
+        }
+
+        // Execute
+        dacite::VMConfig vm_config;
+        vm_config.profile = options.profile_out ? &output_profile : nullptr;
+        vm_config.perf_map = perf_map ? &*perf_map : nullptr;
+        vm_config.perf_line_markers = options.perf;
+        dacite::VM vm(vm_config);
+        auto vm_result = measure(sample[3], [&] { return vm.run(chunk); });
+
+        if (vm_result != dacite::VMResult::OK) {
+            std::cout << "Runtime Error: " << vm.get_error_message() << std::endl;
+            return 1;
+        }
+        if (!vm.is_stack_empty()) {
+            result = vm.peek_stack_top();
         }
-        return 1;
     }
 
-    std::cout << "Parsing successful!" << std::endl;
+    std::cout << "Result: " << result.to_string() << std::endl;
 
-    // Print AST
-    if (program) {
-        std::cout << "AST:" << std::endl;
-        std::cout << program->to_string() << std::endl;
+    if (options.profile_out && !output_profile.save(*options.profile_out)) {
+        std::cerr << "Error: Could not write profile " << *options.profile_out << std::endl;
+        return 1;
+    }
+
+    if (options.time) {
+        std::cout << std::endl;
+        print_timing(samples);
     }
 
     return 0;
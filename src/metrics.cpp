@@ -0,0 +1,137 @@
+#include "metrics.h"
+#include <bit>
+#include <sstream>
+
+namespace dacite {
+
+namespace {
+
+size_t bucket_for(std::chrono::nanoseconds duration) {
+    uint64_t micros = static_cast<uint64_t>(std::chrono::ceil<std::chrono::microseconds>(duration).count());
+    size_t bucket = micros <= 1 ? 0 : static_cast<size_t>(std::bit_width(micros - 1));
+    return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+} // namespace
+
+std::string_view stage_to_string(Stage stage) {
+    switch (stage) {
+        case Stage::LEX:     return "lex";
+        case Stage::PARSE:   return "parse";
+        case Stage::COMPILE: return "compile";
+        case Stage::RUN:     return "run";
+    }
+    return "unknown";
+}
+
+size_t metric_shard_index() {
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t index = next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return index;
+}
+
+uint64_t ShardedCounter::load() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ShardedHistogram::record(std::chrono::nanoseconds duration) {
+    Shard& shard = shards_[metric_shard_index()];
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.total_ns.fetch_add(static_cast<uint64_t>(duration.count()), std::memory_order_relaxed);
+    shard.buckets[bucket_for(duration)].fetch_add(1, std::memory_order_relaxed);
+}
+
+StageStats ShardedHistogram::load() const {
+    StageStats stats;
+    for (const auto& shard : shards_) {
+        stats.count += shard.count.load(std::memory_order_relaxed);
+        stats.total_ns += shard.total_ns.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            stats.buckets[b] += shard.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+
+void Metrics::record_stage(Stage stage, std::chrono::nanoseconds duration) {
+    stages_[static_cast<size_t>(stage)].record(duration);
+}
+
+void Metrics::record_run(uint64_t instructions, bool runtime_error) {
+    vm_runs_.add();
+    instructions_executed_.add(instructions);
+    if (runtime_error) {
+        runtime_errors_.add();
+    }
+}
+
+MetricsSnapshot Metrics::get_stats() const {
+    MetricsSnapshot snapshot;
+    snapshot.vm_runs = vm_runs_.load();
+    snapshot.instructions_executed = instructions_executed_.load();
+    snapshot.runtime_errors = runtime_errors_.load();
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        snapshot.stages[i] = stages_[i].load();
+    }
+    return snapshot;
+}
+
+std::string Metrics::to_prometheus() const {
+    auto stats = get_stats();
+    std::ostringstream oss;
+    oss << "# TYPE dacite_vm_runs_total counter\n";
+    oss << "dacite_vm_runs_total " << stats.vm_runs << "\n";
+    oss << "# TYPE dacite_instructions_executed_total counter\n";
+    oss << "dacite_instructions_executed_total " << stats.instructions_executed << "\n";
+    oss << "# TYPE dacite_runtime_errors_total counter\n";
+    oss << "dacite_runtime_errors_total " << stats.runtime_errors << "\n";
+    oss << "# TYPE dacite_stage_duration_microseconds histogram\n";
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const auto& stage = stats.stages[i];
+        auto name = stage_to_string(static_cast<Stage>(i));
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            cumulative += stage.buckets[b];
+            oss << "dacite_stage_duration_microseconds_bucket{stage=\"" << name << "\",le=\"";
+            if (b + 1 < HISTOGRAM_BUCKETS) {
+                oss << (uint64_t{1} << b);
+            } else {
+                oss << "+Inf";
+            }
+            oss << "\"} " << cumulative << "\n";
+        }
+        oss << "dacite_stage_duration_microseconds_sum{stage=\"" << name << "\"} "
+            << static_cast<double>(stage.total_ns) / 1000.0 << "\n";
+        oss << "dacite_stage_duration_microseconds_count{stage=\"" << name << "\"} "
+            << stage.count << "\n";
+    }
+    return oss.str();
+}
+
+std::string Metrics::to_json() const {
+    auto stats = get_stats();
+    std::ostringstream oss;
+    oss << "{\"vm_runs\":" << stats.vm_runs
+        << ",\"instructions_executed\":" << stats.instructions_executed
+        << ",\"runtime_errors\":" << stats.runtime_errors
+        << ",\"stages\":{";
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const auto& stage = stats.stages[i];
+        if (i > 0) oss << ",";
+        oss << "\"" << stage_to_string(static_cast<Stage>(i)) << "\":{\"count\":" << stage.count
+            << ",\"total_ns\":" << stage.total_ns << ",\"buckets\":[";
+        for (size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            if (b > 0) oss << ",";
+            oss << stage.buckets[b];
+        }
+        oss << "]}";
+    }
+    oss << "}}";
+    return oss.str();
+}
+
+} // namespace dacite
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace dacite {
+
+/// Pipeline stages whose durations are tracked
+enum class Stage {
+    LEX,
+    PARSE,
+    COMPILE,
+    RUN
+};
+
+constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::RUN) + 1;
+
+/// Number of duration histogram buckets: <=1us, <=2us, ..., <=2^20us, +Inf
+constexpr size_t HISTOGRAM_BUCKETS = 22;
+
+/// Convert stage to string for reporting
+std::string_view stage_to_string(Stage stage);
+
+/// Number of shards per sharded metric
+constexpr size_t METRIC_SHARDS = 16;
+
+/// Shard of the calling thread, assigned round-robin on its first use
+size_t metric_shard_index();
+
+/// Lock-free counter split into cache-line sized shards; each thread adds to
+/// its own shard and reads sum all of them
+class ShardedCounter {
+public:
+    void add(uint64_t amount = 1) {
+        shards_[metric_shard_index()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    uint64_t load() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Shard, METRIC_SHARDS> shards_;
+};
+
+/// Aggregated duration statistics for one stage
+struct StageStats {
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    std::array<uint64_t, HISTOGRAM_BUCKETS> buckets{};  // Non-cumulative bucket counts
+};
+
+/// Duration histogram sharded like ShardedCounter: a thread records its
+/// count, total and bucket in its own cache-line aligned shard, and reads
+/// sum the shards
+class ShardedHistogram {
+public:
+    void record(std::chrono::nanoseconds duration);
+
+    StageStats load() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> buckets{};
+    };
+
+    std::array<Shard, METRIC_SHARDS> shards_;
+};
+
+/// Point-in-time view of all metrics
+struct MetricsSnapshot {
+    uint64_t vm_runs = 0;
+    uint64_t instructions_executed = 0;
+    uint64_t runtime_errors = 0;
+    std::array<StageStats, STAGE_COUNT> stages{};
+
+    const StageStats& stage(Stage stage) const { return stages[static_cast<size_t>(stage)]; }
+};
+
+/// Runtime metrics shared by any number of lexers, parsers, compilers and VMs
+class Metrics {
+public:
+    /// Record the duration of one pipeline stage
+    void record_stage(Stage stage, std::chrono::nanoseconds duration);
+
+    /// Record the outcome of one VM run
+    void record_run(uint64_t instructions, bool runtime_error);
+
+    /// Aggregate all counters into a snapshot
+    MetricsSnapshot get_stats() const;
+
+    /// Export in the Prometheus text exposition format
+    std::string to_prometheus() const;
+
+    /// Export as a JSON object
+    std::string to_json() const;
+
+private:
+    ShardedCounter vm_runs_;
+    ShardedCounter instructions_executed_;
+    ShardedCounter runtime_errors_;
+    std::array<ShardedHistogram, STAGE_COUNT> stages_;
+};
+
+/// Records the lifetime of a scope as a stage duration (no-op without metrics)
+class StageTimer {
+public:
+    StageTimer(Metrics* metrics, Stage stage)
+        : metrics_(metrics), stage_(stage) {
+        if (metrics_) start_ = std::chrono::steady_clock::now();
+    }
+
+    ~StageTimer() {
+        if (metrics_) metrics_->record_stage(stage_, std::chrono::steady_clock::now() - start_);
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    Metrics* metrics_;
+    Stage stage_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace dacite
\ No newline at end of file
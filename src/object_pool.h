@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace dacite {
+
+/// Thread-safe free list of reusable objects.
+/// Objects are created by the factory when the free list is empty and passed
+/// through the recycle function when a lease ends, so they come back clean but
+/// keep whatever buffers they have already grown.
+template <typename T>
+class ObjectPool {
+public:
+    using Factory = std::function<std::unique_ptr<T>()>;
+    using Recycler = std::function<void(T&)>;
+
+    /// Exclusive use of one pooled object, returned to the pool on destruction
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(ObjectPool* pool, std::unique_ptr<T> object) : pool_(pool), object_(std::move(object)) {}
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                pool_ = other.pool_;
+                object_ = std::move(other.object_);
+            }
+            return *this;
+        }
+        ~Lease() { release(); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        T& operator*() const { return *object_; }
+        T* operator->() const { return object_.get(); }
+        T* get() const { return object_.get(); }
+        explicit operator bool() const { return object_ != nullptr; }
+
+    private:
+        ObjectPool* pool_ = nullptr;
+        std::unique_ptr<T> object_;
+
+        void release() {
+            if (object_) {
+                pool_->release(std::move(object_));
+            }
+        }
+    };
+
+    /// Create a pool holding `prewarm` ready objects
+    ObjectPool(Factory factory, Recycler recycler, size_t prewarm = 0)
+        : factory_(std::move(factory)), recycler_(std::move(recycler)) {
+        free_.reserve(prewarm);
+        for (size_t i = 0; i < prewarm; ++i) {
+            free_.push_back(factory_());
+        }
+        created_ = prewarm;
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /// Take an object from the free list, creating one if it is empty
+    Lease acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty()) {
+                auto object = std::move(free_.back());
+                free_.pop_back();
+                return Lease(this, std::move(object));
+            }
+            created_++;
+        }
+        return Lease(this, factory_());
+    }
+
+    /// Number of idle objects
+    size_t available() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_.size();
+    }
+
+    /// Number of objects created over the pool's lifetime
+    size_t created() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return created_;
+    }
+
+private:
+    Factory factory_;
+    Recycler recycler_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> free_;
+    size_t created_ = 0;
+
+    void release(std::unique_ptr<T> object) {
+        recycler_(*object);
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(object));
+    }
+};
+
+} // namespace dacite
\ No newline at end of file
@@ -4,38 +4,82 @@
 
 namespace dacite {
 
+namespace {
+
+// Recovery points for panic mode, per construct
+constexpr TokenSet DECLARATION_RECOVERY = {TokenType::FN};
+constexpr TokenSet STATEMENT_RECOVERY = {TokenType::SEMICOLON, TokenType::RETURN, TokenType::RIGHT_BRACE, TokenType::FN};
+
+} // namespace
+
 Parser::Parser(std::vector<Token> tokens, const ParserConfig& config)
-    : tokens_(std::move(tokens)), current_token_(0), config_(config) {
+    : resource_(config.memory_resource ? config.memory_resource : std::pmr::get_default_resource())
+    , tokens_({}, resource_)
+    , current_token_(0), config_(config), errors_(resource_) {
+    tokens_.reserve(tokens.size());
+    for (const auto& token : tokens) {
+        tokens_.push_back(token);
+    }
+}
+
+Parser::Parser(TokenBuffer tokens, const ParserConfig& config)
+    : resource_(config.memory_resource ? config.memory_resource : std::pmr::get_default_resource())
+    , tokens_(std::move(tokens))
+    , current_token_(0), config_(config), errors_(resource_) {
+}
+
+void Parser::reset(std::vector<Token>& tokens) {
+    tokens_.clear();
+    tokens_.reserve(tokens.size());
+    for (const auto& token : tokens) {
+        tokens_.push_back(token);
+    }
+    tokens.clear();
+    restart();
+}
+
+void Parser::reset(TokenBuffer& tokens) {
+    std::swap(tokens_, tokens);
+    tokens.clear();
+    restart();
+}
+
+void Parser::restart() {
+    current_token_ = 0;
+    errors_.clear();
+    panic_mode_ = false;
+    error_limit_reached_ = false;
 }
 
 std::unique_ptr<Program> Parser::parse() {
+    StageTimer timer(config_.metrics, Stage::PARSE);
     debug_print("Starting parse");
     return parse_program();
 }
 
-const Token& Parser::current_token() const {
-    if (current_token_ >= tokens_.size()) {
-        static Token eof_token(TokenType::EOF_TOKEN, SourceSpan{});
-        return eof_token;
+std::unique_ptr<Expression> Parser::parse_standalone_expression() {
+    StageTimer timer(config_.metrics, Stage::PARSE);
+    debug_print("Parsing standalone expression");
+    
+    auto expression = parse_expression();
+    match(TokenType::SEMICOLON);
+    
+    if (expression && !at_end()) {
+        report_error("Unexpected token after expression");
     }
-    return tokens_[current_token_];
+    return expression;
 }
 
-const Token& Parser::peek_token(size_t offset) const {
-    size_t index = current_token_ + offset;
-    if (index >= tokens_.size()) {
-        static Token eof_token(TokenType::EOF_TOKEN, SourceSpan{});
-        return eof_token;
-    }
-    return tokens_[index];
+TokenType Parser::peek_type(size_t offset) const {
+    return tokens_.type(current_token_ + offset);
 }
 
 bool Parser::at_end() const {
-    return current_token_ >= tokens_.size() || current_token().type == TokenType::EOF_TOKEN;
+    return tokens_.type(current_token_) == TokenType::EOF_TOKEN;
 }
 
 bool Parser::check(TokenType type) const {
-    return current_token().type == type;
+    return tokens_.type(current_token_) == type;
 }
 
 bool Parser::match(TokenType type) {
@@ -56,15 +100,15 @@ bool Parser::match(const std::vector<TokenType>& types) {
     return false;
 }
 
-Token Parser::consume(TokenType type, const std::string& error_message) {
+size_t Parser::consume(TokenType type, std::string_view error_message) {
+    size_t token = current_token_;
     if (check(type)) {
-        Token token = current_token();
         advance();
         return token;
     }
     
     report_error(error_message);
-    return current_token(); // Return current token even on error
+    return token; // Return current token even on error
 }
 
 void Parser::advance() {
@@ -73,8 +117,22 @@ void Parser::advance() {
     }
 }
 
-void Parser::report_error(const std::string& message, const SourceSpan& span) {
-    errors_.emplace_back(message, span);
+void Parser::report_error(std::string_view message, const SourceSpan& span) {
+    if (panic_mode_ || error_limit_reached_) {
+        return;
+    }
+    panic_mode_ = true;
+    errors_.emplace_back(std::string(message), span);
+    
+    // Past the limit the rest of the input is skipped, which bounds the work on garbage input
+    size_t limit = config_.recover_from_errors ? config_.max_errors : 1;
+    if (limit > 0 && errors_.size() >= limit) {
+        error_limit_reached_ = true;
+        if (config_.recover_from_errors) {
+            errors_.emplace_back("Too many errors, stopping", span);
+        }
+        current_token_ = tokens_.size();
+    }
     if (config_.debug_mode) {
         std::cerr << "Parser error at line " << span.start.line 
                   << ", column " << span.start.column 
@@ -82,11 +140,11 @@ void Parser::report_error(const std::string& message, const SourceSpan& span) {
     }
 }
 
-void Parser::report_error(const std::string& message) {
-    report_error(message, current_token().span);
+void Parser::report_error(std::string_view message) {
+    report_error(message, tokens_.span(current_token_));
 }
 
-void Parser::debug_print(const std::string& message) {
+void Parser::debug_print(std::string_view message) {
     if (config_.debug_mode) {
         std::cout << "[Parser] " << message << std::endl;
     }
@@ -103,9 +161,12 @@ std::unique_ptr<Program> Parser::parse_program() {
         if (package_decl) {
             program->set_package_declaration(std::move(package_decl));
         }
+        if (panic_mode_) {
+            synchronize(DECLARATION_RECOVERY);
+        }
     }
     
-    // Parse declarations
+    // Parse declarations, skipping to the next 'fn' after anything else
     while (!at_end()) {
         if (check(TokenType::FN)) {
             auto func_decl = parse_function_declaration();
@@ -114,7 +175,10 @@ std::unique_ptr<Program> Parser::parse_program() {
             }
         } else {
             report_error("Expected function declaration");
-            break;
+            advance();
+        }
+        if (panic_mode_) {
+            synchronize(DECLARATION_RECOVERY);
         }
     }
     
@@ -124,19 +188,19 @@ std::unique_ptr<Program> Parser::parse_program() {
 std::unique_ptr<PackageDeclaration> Parser::parse_package_declaration() {
     debug_print("Parsing package declaration");
     
-    auto package_token = consume(TokenType::PACKAGE, "Expected 'package'");
-    auto name_token = consume(TokenType::IDENTIFIER, "Expected package name");
+    size_t package_token = consume(TokenType::PACKAGE, "Expected 'package'");
+    size_t name_token = consume(TokenType::IDENTIFIER, "Expected package name");
     consume(TokenType::SEMICOLON, "Expected ';' after package declaration");
     
-    SourceSpan span(package_token.span.start, name_token.span.end);
-    return std::make_unique<PackageDeclaration>(name_token.value, span);
+    SourceSpan span(tokens_.span(package_token).start, tokens_.span(name_token).end);
+    return std::make_unique<PackageDeclaration>(std::string(tokens_.value(name_token)), span);
 }
 
 std::unique_ptr<FunctionDeclaration> Parser::parse_function_declaration() {
     debug_print("Parsing function declaration");
     
-    auto fn_token = consume(TokenType::FN, "Expected 'fn'");
-    auto name_token = consume(TokenType::IDENTIFIER, "Expected function name");
+    size_t fn_token = consume(TokenType::FN, "Expected 'fn'");
+    size_t name_token = consume(TokenType::IDENTIFIER, "Expected function name");
     
     // Parse parameter list (simplified - just consume parentheses for now)
     consume(TokenType::LEFT_PAREN, "Expected '(' after function name");
@@ -148,21 +212,20 @@ std::unique_ptr<FunctionDeclaration> Parser::parse_function_declaration() {
     // Parse function body
     auto body = parse_block_statement();
     
-    SourceSpan span(fn_token.span.start, body ? body->span.end : current_token().span.end);
-    return std::make_unique<FunctionDeclaration>(name_token.value, std::move(return_type), std::move(body), span);
+    SourceSpan span(tokens_.span(fn_token).start, body ? body->span.end : tokens_.span(current_token_).end);
+    auto function = std::make_unique<FunctionDeclaration>(std::string(tokens_.value(name_token)), std::move(return_type),
+                                                          std::move(body), span);
+    function->name_span = tokens_.span(name_token);
+    return function;
 }
 
 std::unique_ptr<Type> Parser::parse_type() {
     debug_print("Parsing type");
     
-    if (check(TokenType::VOID)) {
-        auto type_token = current_token();
-        advance();
-        return std::make_unique<Type>(type_token.value, type_token.span);
-    } else if (check(TokenType::IDENTIFIER)) {
-        auto type_token = current_token();
+    if (check(TokenType::VOID) || check(TokenType::IDENTIFIER)) {
+        size_t type_token = current_token_;
         advance();
-        return std::make_unique<Type>(type_token.value, type_token.span);
+        return std::make_unique<Type>(std::string(tokens_.value(type_token)), tokens_.span(type_token));
     } else {
         report_error("Expected type name");
         return nullptr;
@@ -172,21 +235,19 @@ std::unique_ptr<Type> Parser::parse_type() {
 std::unique_ptr<BlockStatement> Parser::parse_block_statement() {
     debug_print("Parsing block statement");
     
-    auto left_brace = consume(TokenType::LEFT_BRACE, "Expected '{'");
-    auto block = std::make_unique<BlockStatement>(left_brace.span);
+    size_t left_brace = consume(TokenType::LEFT_BRACE, "Expected '{'");
+    auto block = std::make_unique<BlockStatement>(tokens_.span(left_brace), resource_);
     
-    while (!check(TokenType::RIGHT_BRACE) && !at_end()) {
-        auto statement = parse_statement();
-        if (statement) {
-            block->add_statement(std::move(statement));
-        } else {
-            // Error recovery: skip to next statement or end of block
-            synchronize();
+    // A 'fn' means the closing brace is missing; leave it to the declaration loop
+    while (!check(TokenType::RIGHT_BRACE) && !check(TokenType::FN) && !at_end()) {
+        block->add_statement(parse_statement());
+        if (panic_mode_) {
+            synchronize(STATEMENT_RECOVERY);
         }
     }
     
-    auto right_brace = consume(TokenType::RIGHT_BRACE, "Expected '}' after block");
-    block->span.end = right_brace.span.end;
+    size_t right_brace = consume(TokenType::RIGHT_BRACE, "Expected '}' after block");
+    block->span.end = tokens_.span(right_brace).end;
     
     return block;
 }
@@ -198,26 +259,44 @@ std::unique_ptr<Statement> Parser::parse_statement() {
         return parse_return_statement();
     }
     
+    // Only calls have effects, so only a call can start an expression statement
+    if (check(TokenType::IDENTIFIER) && peek_type() == TokenType::LEFT_PAREN) {
+        return parse_expression_statement();
+    }
+    
+    // The tokens skipped by recovery become part of the error node
+    SourceSpan start = tokens_.span(current_token_);
     report_error("Expected statement");
-    return nullptr;
+    synchronize(STATEMENT_RECOVERY);
+    return std::make_unique<ErrorStatement>(SourceSpan(start.start, tokens_.span(current_token_ - 1).end));
 }
 
 std::unique_ptr<ReturnStatement> Parser::parse_return_statement() {
     debug_print("Parsing return statement");
     
-    auto return_token = consume(TokenType::RETURN, "Expected 'return'");
+    size_t return_token = consume(TokenType::RETURN, "Expected 'return'");
     
     ExpressionPtr expression = nullptr;
     if (!check(TokenType::SEMICOLON)) {
         expression = parse_expression();
     }
     
-    auto semicolon = consume(TokenType::SEMICOLON, "Expected ';' after return statement");
+    size_t semicolon = consume(TokenType::SEMICOLON, "Expected ';' after return statement");
     
-    SourceSpan span(return_token.span.start, semicolon.span.end);
+    SourceSpan span(tokens_.span(return_token).start, tokens_.span(semicolon).end);
     return std::make_unique<ReturnStatement>(std::move(expression), span);
 }
 
+std::unique_ptr<ExpressionStatement> Parser::parse_expression_statement() {
+    debug_print("Parsing expression statement");
+    
+    auto expression = parse_expression();
+    size_t semicolon = consume(TokenType::SEMICOLON, "Expected ';' after expression");
+    
+    SourceSpan span(expression->span.start, tokens_.span(semicolon).end);
+    return std::make_unique<ExpressionStatement>(std::move(expression), span);
+}
+
 std::unique_ptr<Expression> Parser::parse_expression() {
     debug_print("Parsing expression");
     
@@ -232,12 +311,12 @@ std::unique_ptr<Expression> Parser::parse_comparison() {
     while (check(TokenType::EQUAL) || check(TokenType::NOT_EQUAL) ||
            check(TokenType::LESS_THAN) || check(TokenType::LESS_EQUAL) ||
            check(TokenType::GREATER_THAN) || check(TokenType::GREATER_EQUAL)) {
-        auto operator_token = current_token();
+        TokenType operator_type = tokens_.type(current_token_);
         advance();
         auto right = parse_term();
         
         SourceSpan span(expr->span.start, right->span.end);
-        auto op = token_to_binary_operator(operator_token.type);
+        auto op = token_to_binary_operator(operator_type);
         expr = std::make_unique<BinaryExpression>(std::move(expr), op, std::move(right), span);
     }
     
@@ -250,12 +329,12 @@ std::unique_ptr<Expression> Parser::parse_term() {
     auto expr = parse_factor();
     
     while (check(TokenType::PLUS) || check(TokenType::MINUS)) {
-        auto operator_token = current_token();
+        TokenType operator_type = tokens_.type(current_token_);
         advance();
         auto right = parse_factor();
         
         SourceSpan span(expr->span.start, right->span.end);
-        auto op = token_to_binary_operator(operator_token.type);
+        auto op = token_to_binary_operator(operator_type);
         expr = std::make_unique<BinaryExpression>(std::move(expr), op, std::move(right), span);
     }
     
@@ -268,12 +347,12 @@ std::unique_ptr<Expression> Parser::parse_factor() {
     auto expr = parse_primary_expression();
     
     while (check(TokenType::MULTIPLY) || check(TokenType::DIVIDE)) {
-        auto operator_token = current_token();
+        TokenType operator_type = tokens_.type(current_token_);
         advance();
         auto right = parse_primary_expression();
         
         SourceSpan span(expr->span.start, right->span.end);
-        auto op = token_to_binary_operator(operator_token.type);
+        auto op = token_to_binary_operator(operator_type);
         expr = std::make_unique<BinaryExpression>(std::move(expr), op, std::move(right), span);
     }
     
@@ -284,34 +363,60 @@ std::unique_ptr<Expression> Parser::parse_primary_expression() {
     debug_print("Parsing primary expression");
     
     if (check(TokenType::INTEGER_LITERAL)) {
-        auto token = current_token();
+        size_t token = current_token_;
+        advance();
+        return std::make_unique<IntegerLiteral>(std::string(tokens_.value(token)), tokens_.integer_value(token),
+                                                tokens_.span(token));
+    }
+    
+    if (check(TokenType::FLOAT_LITERAL)) {
+        size_t token = current_token_;
         advance();
-        return std::make_unique<IntegerLiteral>(token.value, token.span);
+        return std::make_unique<FloatLiteral>(std::string(tokens_.value(token)), tokens_.float_value(token),
+                                              tokens_.span(token));
     }
     
+    if (check(TokenType::STRING_LITERAL)) {
+        size_t token = current_token_;
+        advance();
+        return std::make_unique<StringLiteral>(std::string(tokens_.value(token)), tokens_.span(token));
+    }
+    
+    if (check(TokenType::IDENTIFIER) && peek_type() == TokenType::LEFT_PAREN) {
+        return parse_call_expression();
+    }
+    
+    // Leave the token for the enclosing statement's recovery
     report_error("Expected expression");
-    return nullptr;
+    return std::make_unique<ErrorExpression>(tokens_.span(current_token_));
 }
 
-void Parser::synchronize() {
-    advance();
+std::unique_ptr<Expression> Parser::parse_call_expression() {
+    debug_print("Parsing call expression");
     
-    while (!at_end()) {
-        if (current_token().type == TokenType::SEMICOLON) {
-            advance();
-            return;
-        }
-        
-        switch (current_token().type) {
-            case TokenType::FN:
-            case TokenType::RETURN:
-                return;
-            default:
-                break;
-        }
-        
+    size_t name_token = consume(TokenType::IDENTIFIER, "Expected function name");
+    consume(TokenType::LEFT_PAREN, "Expected '(' after function name");
+    
+    std::vector<ExpressionPtr> arguments;
+    if (!check(TokenType::RIGHT_PAREN)) {
+        do {
+            arguments.push_back(parse_expression());
+        } while (match(TokenType::COMMA));
+    }
+    size_t right_paren = consume(TokenType::RIGHT_PAREN, "Expected ')' after arguments");
+    
+    SourceSpan span(tokens_.span(name_token).start, tokens_.span(right_paren).end);
+    return std::make_unique<CallExpression>(std::string(tokens_.value(name_token)), std::move(arguments), span);
+}
+
+void Parser::synchronize(const TokenSet& recovery) {
+    panic_mode_ = false;
+    while (!at_end() && !recovery.contains(tokens_.type(current_token_))) {
         advance();
     }
+    if (recovery.contains(TokenType::SEMICOLON)) {
+        match(TokenType::SEMICOLON);
+    }
 }
 
 BinaryOperator Parser::token_to_binary_operator(TokenType token_type) {
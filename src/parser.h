@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstdint>
+#include <initializer_list>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
+#include <string_view>
 #include "ast.h"
 #include "token.h"
 #include "lexer.h"
+#include "token_buffer.h"
 
 namespace dacite {
 
@@ -22,45 +27,84 @@ struct ParserError {
 struct ParserConfig {
     bool debug_mode = false;        // Print parsing steps
     bool recover_from_errors = true; // Try to continue parsing after errors
+    size_t max_errors = 100;         // Stop parsing after this many errors (0 = no limit)
+    Metrics* metrics = nullptr;      // Record parse timings when set
+    std::pmr::memory_resource* memory_resource = nullptr; // Allocate tokens, errors and blocks from this when set
 };
 
+/// Set of token types, used as the recovery points of panic-mode error recovery
+class TokenSet {
+public:
+    constexpr TokenSet(std::initializer_list<TokenType> types) {
+        for (TokenType type : types) {
+            bits_ |= bit(type);
+        }
+    }
+
+    constexpr bool contains(TokenType type) const { return (bits_ & bit(type)) != 0; }
+
+private:
+    uint64_t bits_ = 0;
+
+    static constexpr uint64_t bit(TokenType type) { return uint64_t{1} << static_cast<unsigned>(type); }
+};
+
+static_assert(static_cast<unsigned>(TokenType::ERROR) < 64, "TokenSet holds at most 64 token types");
+
 /// The main parser class for parsing dacite tokens into an AST
 class Parser {
 public:
     /// Create a parser for the given token stream
     explicit Parser(std::vector<Token> tokens, const ParserConfig& config = {});
 
+    /// Create a parser over a token buffer produced by Lexer::tokenize_all(TokenBuffer&)
+    explicit Parser(TokenBuffer tokens, const ParserConfig& config = {});
+
+    /// Restart on a new token stream, keeping the token and error buffers' capacity.
+    /// The tokens are copied in, leaving `tokens` empty with its own capacity intact.
+    void reset(std::vector<Token>& tokens);
+
+    /// Restart on a new token buffer. The buffers are swapped, so `tokens` comes
+    /// back empty holding the previous buffer's capacity.
+    void reset(TokenBuffer& tokens);
+
     /// Parse the tokens into a Program AST
     std::unique_ptr<Program> parse();
+    
+    /// Parse the tokens as a single expression with an optional trailing ';'
+    std::unique_ptr<Expression> parse_standalone_expression();
 
     /// Get any errors that occurred during parsing
-    const std::vector<ParserError>& get_errors() const { return errors_; }
+    const std::pmr::vector<ParserError>& get_errors() const { return errors_; }
 
     /// Check if any errors occurred
     bool has_errors() const { return !errors_.empty(); }
 
 private:
-    std::vector<Token> tokens_;
+    std::pmr::memory_resource* resource_;
+    TokenBuffer tokens_;
     size_t current_token_;
     ParserConfig config_;
-    std::vector<ParserError> errors_;
+    std::pmr::vector<ParserError> errors_;
+    bool panic_mode_ = false;            // Suppress cascading errors until the next recovery point
+    bool error_limit_reached_ = false;
 
-    // Token management
-    const Token& current_token() const;
-    const Token& peek_token(size_t offset = 1) const;
+    // Token management; only the dense type array is read until a value or span is needed
+    TokenType peek_type(size_t offset = 1) const;
     bool at_end() const;
     bool check(TokenType type) const;
     bool match(TokenType type);
     bool match(const std::vector<TokenType>& types);
-    Token consume(TokenType type, const std::string& error_message);
+    size_t consume(TokenType type, std::string_view error_message);  // Returns the token's index
     void advance();
+    void restart();
 
     // Error reporting
-    void report_error(const std::string& message, const SourceSpan& span);
-    void report_error(const std::string& message);
+    void report_error(std::string_view message, const SourceSpan& span);
+    void report_error(std::string_view message);
 
     // Debug output
-    void debug_print(const std::string& message);
+    void debug_print(std::string_view message);
 
     // Parsing methods
     std::unique_ptr<Program> parse_program();
@@ -70,17 +114,20 @@ private:
     std::unique_ptr<BlockStatement> parse_block_statement();
     std::unique_ptr<Statement> parse_statement();
     std::unique_ptr<ReturnStatement> parse_return_statement();
+    std::unique_ptr<ExpressionStatement> parse_expression_statement();
     std::unique_ptr<Expression> parse_expression();
     std::unique_ptr<Expression> parse_comparison();
     std::unique_ptr<Expression> parse_term();
     std::unique_ptr<Expression> parse_factor();
     std::unique_ptr<Expression> parse_primary_expression();
+    std::unique_ptr<Expression> parse_call_expression();
 
     // Helper methods for expression parsing
     BinaryOperator token_to_binary_operator(TokenType token_type);
 
-    // Synchronization for error recovery
-    void synchronize();
+    // Panic-mode recovery: skip to the next token in `recovery` and leave panic mode.
+    // A ';' in the set is consumed, other members are left for the caller.
+    void synchronize(const TokenSet& recovery);
 };
 
 } // namespace dacite
\ No newline at end of file
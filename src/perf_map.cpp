@@ -0,0 +1,119 @@
+#include "perf_map.h"
+#include <cstring>
+#include <ios>
+
+#if defined(_WIN32)
+#include <process.h>
+#define DACITE_GETPID _getpid
+#else
+#include <unistd.h>
+#define DACITE_GETPID getpid
+#endif
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#define DACITE_NATIVE_THUNKS 1
+#endif
+
+namespace dacite {
+
+namespace {
+
+#if defined(DACITE_NATIVE_THUNKS)
+constexpr size_t PAGE_SIZE = 4096;
+
+/// push rbp; mov rbp, rsp; call [rip + 6]; pop rbp; ret; then the target at
+/// offset 16. The frame keeps the thunk's return address on frame-pointer call
+/// chains, and argument and return registers pass through untouched.
+constexpr unsigned char THUNK_CODE[] = {
+    0x55,                               // push rbp
+    0x48, 0x89, 0xE5,                   // mov rbp, rsp
+    0xFF, 0x15, 0x06, 0x00, 0x00, 0x00, // call qword ptr [rip + 6]
+    0x5D,                               // pop rbp
+    0xC3,                               // ret
+    0xCC, 0xCC, 0xCC, 0xCC,             // int3 padding up to the target
+};
+constexpr size_t THUNK_TARGET_OFFSET = sizeof(THUNK_CODE);
+static_assert(THUNK_TARGET_OFFSET + sizeof(void*) <= PerfMap::THUNK_SIZE);
+#endif
+
+} // namespace
+
+PerfMap::PerfMap()
+    : PerfMap("/tmp/perf-" + std::to_string(DACITE_GETPID()) + ".map") {}
+
+PerfMap::PerfMap(const std::string& path)
+    : path_(path), file_(path, std::ios::out | std::ios::app) {}
+
+PerfMap::~PerfMap() {
+#if defined(DACITE_NATIVE_THUNKS)
+    for (void* page : pages_) {
+        ::munmap(page, PAGE_SIZE);
+    }
+#endif
+}
+
+bool PerfMap::add(const void* start, size_t size, std::string_view name) {
+    std::lock_guard lock(mutex_);
+    return write_entry(start, size, name);
+}
+
+bool PerfMap::write_entry(const void* start, size_t size, std::string_view name) {
+    if (!is_open() || size == 0) {
+        return false;
+    }
+    
+    // Format: <start hex> <size hex> <symbol name>
+    file_ << std::hex << reinterpret_cast<uintptr_t>(start) << " " << size << std::dec
+          << " " << name << "\n";
+    file_.flush();
+    return static_cast<bool>(file_);
+}
+
+const void* PerfMap::thunk(const std::string& name, const void* target) {
+    std::lock_guard lock(mutex_);
+    auto it = thunks_.find(name);
+    if (it != thunks_.end() && it->second.target == target) {
+        return it->second.code;
+    }
+    
+    void* code = make_thunk(target);
+    if (!code) {
+        return nullptr;
+    }
+    write_entry(code, THUNK_SIZE, name);
+    thunks_[name] = {target, code};
+    return code;
+}
+
+void* PerfMap::make_thunk(const void* target) {
+#if defined(DACITE_NATIVE_THUNKS)
+    // Each thunk gets its own page, written while no other thread can reach it,
+    // so a page that may be executing is never made writable again. There is
+    // one thunk per function name, so the pages stay few.
+    void* page = ::mmap(nullptr, PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (page == MAP_FAILED) {
+        return nullptr;
+    }
+    auto* bytes = static_cast<unsigned char*>(page);
+    std::memcpy(bytes, THUNK_CODE, sizeof(THUNK_CODE));
+    std::memcpy(bytes + THUNK_TARGET_OFFSET, &target, sizeof(target));
+    if (::mprotect(page, PAGE_SIZE, PROT_READ | PROT_EXEC) != 0) {
+        ::munmap(page, PAGE_SIZE);
+        return nullptr;
+    }
+    pages_.push_back(page);
+    return page;
+#else
+    (void)target;
+    return nullptr;
+#endif
+}
+
+} // namespace dacite
+
+// Kept out of line; the empty asm uses both arguments and clobbers memory, so
+// neither the call nor its arguments can be optimized away from the uprobe site
+extern "C" void dacite_perf_line(const char* function, size_t line) {
+    asm volatile("" : : "r"(function), "r"(line) : "memory");
+}
\ No newline at end of file
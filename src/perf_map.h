@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace dacite {
+
+/// Writer for the perf map file (/tmp/perf-<pid>.map) that Linux perf
+/// reads to symbolize addresses it cannot resolve from the binary.
+///
+/// Bytecode is data, so perf never samples an address inside it. Instead each
+/// dacite function gets a small native thunk that calls into the interpreter;
+/// the thunk's code range is what the map names, so call graphs recorded
+/// with frame pointers show the dacite function above VM::execute.
+/// One map may be shared by VMs on several threads.
+class PerfMap {
+public:
+    /// Size of the code range registered for each thunk
+    static constexpr size_t THUNK_SIZE = 32;
+    
+    /// Open the perf map of the current process
+    PerfMap();
+    
+    /// Open a perf map at a custom path (for testing)
+    explicit PerfMap(const std::string& path);
+    
+    /// Unmaps the thunks, which must no longer be running
+    ~PerfMap();
+    
+    PerfMap(const PerfMap&) = delete;
+    PerfMap& operator=(const PerfMap&) = delete;
+    
+    /// Check if the map file could be opened
+    bool is_open() const { return file_.is_open(); }
+    
+    /// Get the path of the map file
+    const std::string& get_path() const { return path_; }
+    
+    /// Write a named address range to the map
+    bool add(const void* start, size_t size, std::string_view name);
+    
+    /// Native code named `name` that calls `target` with the caller's arguments
+    /// and returns its result. Generated and written to the map on the first
+    /// request per name, so names always describe live code. Returns nullptr
+    /// where thunks cannot be generated (targets other than x86-64 Linux, or
+    /// no executable memory); callers then call `target` directly.
+    const void* thunk(const std::string& name, const void* target);
+
+private:
+    struct Thunk {
+        const void* target;
+        const void* code;
+    };
+    
+    std::string path_;
+    std::mutex mutex_;             // Guards everything below and writes to file_
+    std::ofstream file_;
+    std::unordered_map<std::string, Thunk> thunks_;
+    std::vector<void*> pages_;     // One executable page per thunk, never written once published
+    
+    // Write an entry; the caller holds mutex_
+    bool write_entry(const void* start, size_t size, std::string_view name);
+    
+    // Map a new page holding a thunk that calls `target`, read+execute before it is returned
+    void* make_thunk(const void* target);
+};
+
+} // namespace dacite
+
+/// Marker the VM calls whenever execution moves to a new source line while
+/// VMConfig::perf_line_markers is set. Attach a uprobe to it to attribute
+/// samples to dacite functions and lines, e.g.
+///   perf probe -x .bin/dacite 'dacite_perf_line function:string line'
+extern "C" void dacite_perf_line(const char* function, size_t line);
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "pipeline_pool.h"
+
+namespace dacite {
+
+VMPool::VMPool(const VMConfig& config, size_t prewarm)
+    : ObjectPool<VM>(
+          [config] {
+              auto vm = std::make_unique<VM>(config);
+              vm->reserve_stack();
+              return vm;
+          },
+          [](VM& vm) { vm.reset(); },
+          prewarm) {}
+
+ChunkPool::ChunkPool(size_t prewarm)
+    : ObjectPool<Chunk>(
+          [] { return std::make_unique<Chunk>(); },
+          [](Chunk& chunk) { chunk.clear(); },
+          prewarm) {}
+
+} // namespace dacite
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include "object_pool.h"
+#include "chunk.h"
+#include "vm.h"
+
+namespace dacite {
+
+/// Pool of VMs whose stacks are reserved up front, reset between leases
+class VMPool : public ObjectPool<VM> {
+public:
+    explicit VMPool(const VMConfig& config = {}, size_t prewarm = 1);
+};
+
+/// Pool of chunks, cleared between leases with their buffers' capacity kept
+class ChunkPool : public ObjectPool<Chunk> {
+public:
+    explicit ChunkPool(size_t prewarm = 1);
+};
+
+} // namespace dacite
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "profile.h"
+#include <fstream>
+#include <sstream>
+
+namespace dacite {
+
+namespace {
+
+constexpr const char* PROFILE_HEADER = "dacite-profile 1";
+
+std::optional<OpCode> opcode_from_string(const std::string& name) {
+    for (size_t i = 0; i < OPCODE_COUNT; ++i) {
+        auto opcode = static_cast<OpCode>(i);
+        if (opcode_to_string(opcode) == name) {
+            return opcode;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+bool Profile::is_integer_only(OpCode opcode) const {
+    constexpr uint8_t integer_bit = 1u << static_cast<unsigned>(ValueType::INTEGER);
+    return count(opcode) > 0 && operand_types[static_cast<size_t>(opcode)] == integer_bit;
+}
+
+bool Profile::is_integer_only(OpCode plain, OpCode fused) const {
+    constexpr uint8_t integer_bit = 1u << static_cast<unsigned>(ValueType::INTEGER);
+    uint8_t seen = operand_types[static_cast<size_t>(plain)] | operand_types[static_cast<size_t>(fused)];
+    return count(plain) + count(fused) > 0 && seen == integer_bit;
+}
+
+void Profile::merge(const Profile& other) {
+    runs += other.runs;
+    for (size_t i = 0; i < OPCODE_COUNT; ++i) {
+        opcode_counts[i] += other.opcode_counts[i];
+        operand_types[i] |= other.operand_types[i];
+    }
+}
+
+std::string Profile::to_string() const {
+    std::ostringstream oss;
+    oss << PROFILE_HEADER << "\n";
+    oss << "runs " << runs << "\n";
+    for (size_t i = 0; i < OPCODE_COUNT; ++i) {
+        if (opcode_counts[i] == 0) continue;
+        oss << opcode_to_string(static_cast<OpCode>(i)) << " " << opcode_counts[i]
+            << " " << static_cast<int>(operand_types[i]) << "\n";
+    }
+    return oss.str();
+}
+
+bool Profile::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << to_string();
+    return static_cast<bool>(file);
+}
+
+std::optional<Profile> Profile::parse(const std::string& text) {
+    std::istringstream iss(text);
+    std::string line;
+    if (!std::getline(iss, line) || line != PROFILE_HEADER) {
+        return std::nullopt;
+    }
+
+    Profile profile;
+    std::string key;
+    if (!(iss >> key >> profile.runs) || key != "runs") {
+        return std::nullopt;
+    }
+
+    std::string name;
+    uint64_t count;
+    int types;
+    while (iss >> name >> count >> types) {
+        auto opcode = opcode_from_string(name);
+        if (!opcode) {
+            return std::nullopt;
+        }
+        profile.opcode_counts[static_cast<size_t>(*opcode)] = count;
+        profile.operand_types[static_cast<size_t>(*opcode)] = static_cast<uint8_t>(types);
+    }
+    if (!iss.eof()) {
+        return std::nullopt;
+    }
+    return profile;
+}
+
+std::optional<Profile> Profile::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return parse(text);
+}
+
+} // namespace dacite
\ No newline at end of file
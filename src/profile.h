@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "chunk.h"
+#include "value.h"
+
+namespace dacite {
+
+/// Execution profile collected by the VM and fed back into the compiler
+struct Profile {
+    uint64_t runs = 0;                                   // Number of VM runs recorded
+    std::array<uint64_t, OPCODE_COUNT> opcode_counts{};  // Executions per opcode
+    std::array<uint8_t, OPCODE_COUNT> operand_types{};   // Bitmask of ValueTypes seen as operands
+
+    /// Record one execution of an opcode
+    void record_opcode(OpCode opcode) { opcode_counts[static_cast<size_t>(opcode)]++; }
+
+    /// Record the type of an operand consumed by an opcode
+    void record_operand(OpCode opcode, ValueType type) {
+        operand_types[static_cast<size_t>(opcode)] |= static_cast<uint8_t>(1u << static_cast<unsigned>(type));
+    }
+
+    /// Get how many times an opcode was executed
+    uint64_t count(OpCode opcode) const { return opcode_counts[static_cast<size_t>(opcode)]; }
+
+    /// Check if an opcode executed and only ever saw integer operands
+    bool is_integer_only(OpCode opcode) const;
+
+    /// Check if an operator executed in either its plain or its fused form and only
+    /// ever saw integer operands, so profiles of fused builds keep their fusion
+    bool is_integer_only(OpCode plain, OpCode fused) const;
+
+    /// Add the counts of another profile to this one
+    void merge(const Profile& other);
+
+    /// Serialize the profile to its text format
+    std::string to_string() const;
+
+    /// Write the profile to a file, returns false on I/O failure
+    bool save(const std::string& path) const;
+
+    /// Parse a profile from its text format
+    static std::optional<Profile> parse(const std::string& text);
+
+    /// Read a profile from a file
+    static std::optional<Profile> load(const std::string& path);
+};
+
+} // namespace dacite
\ No newline at end of file
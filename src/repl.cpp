@@ -0,0 +1,98 @@
+#include "repl.h"
+#include <sstream>
+#include "lexer.h"
+#include "parser.h"
+
+namespace dacite {
+
+namespace {
+
+template <typename Errors>
+ReplResult error_result(const Errors& errors) {
+    std::ostringstream oss;
+    for (size_t i = 0; i < errors.size(); ++i) {
+        if (i > 0) oss << "\n";
+        oss << "Error at line " << errors[i].span.start.line
+            << ", column " << errors[i].span.start.column
+            << ": " << errors[i].message;
+    }
+    return {false, oss.str()};
+}
+
+CompilerConfig make_compiler_config(const ReplConfig& config) {
+    CompilerConfig compiler_config;
+    compiler_config.debug_mode = config.debug_mode;
+    compiler_config.metrics = config.metrics;
+    return compiler_config;
+}
+
+VMConfig make_vm_config(const ReplConfig& config) {
+    VMConfig vm_config;
+    vm_config.debug_mode = config.debug_mode;
+    vm_config.metrics = config.metrics;
+    return vm_config;
+}
+
+} // namespace
+
+Repl::Repl(const ReplConfig& config)
+    : config_(config), compiler_(make_compiler_config(config)), vm_(make_vm_config(config)) {}
+
+ReplResult Repl::eval(std::string_view input) {
+    input_count_++;
+    // Drop the previous result before the constants it may reference
+    vm_.reset();
+    chunk_.clear();
+    
+    LexerConfig lexer_config;
+    lexer_config.metrics = config_.metrics;
+    Lexer lexer(input, lexer_config);
+    auto tokens = lexer.tokenize_all();
+    if (lexer.has_errors()) {
+        return error_result(lexer.get_errors());
+    }
+    
+    // Declarations are compiled as a whole program, anything else as an expression
+    bool is_declaration = !tokens.empty() &&
+        (tokens.front().type == TokenType::PACKAGE || tokens.front().type == TokenType::FN);
+    
+    ParserConfig parser_config;
+    parser_config.debug_mode = config_.debug_mode;
+    parser_config.metrics = config_.metrics;
+    Parser parser(std::move(tokens), parser_config);
+    
+    CompileResult compile_result;
+    if (is_declaration) {
+        auto program = parser.parse();
+        if (parser.has_errors()) {
+            return error_result(parser.get_errors());
+        }
+        compile_result = compiler_.compile(*program, chunk_);
+    } else {
+        auto expression = parser.parse_standalone_expression();
+        if (parser.has_errors()) {
+            return error_result(parser.get_errors());
+        }
+        if (!expression) {
+            return {false, "Expected expression"};
+        }
+        compile_result = compiler_.compile_standalone_expression(*expression, chunk_);
+    }
+    
+    if (compile_result != CompileResult::OK) {
+        return {false, "Compile error: " + compiler_.get_error_message()};
+    }
+    return run_chunk();
+}
+
+ReplResult Repl::run_chunk() {
+    if (vm_.run(chunk_) != VMResult::OK) {
+        return {false, "Runtime error: " + vm_.get_error_message()};
+    }
+    if (vm_.is_stack_empty()) {
+        return {true, ""};
+    }
+    return {true, vm_.peek_stack_top().to_string()};
+}
+
+} // namespace dacite
\ No newline at end of file
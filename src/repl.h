@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include "chunk.h"
+#include "compiler.h"
+#include "vm.h"
+
+namespace dacite {
+
+/// Configuration for the REPL
+struct ReplConfig {
+    bool debug_mode = false;
+    Metrics* metrics = nullptr;    // Record per-stage timings of every input when set
+};
+
+/// Result of evaluating one REPL input
+struct ReplResult {
+    bool ok;
+    std::string output;            // Printed value, or the error messages
+};
+
+/// Read-eval-print loop that evaluates inputs against a long-lived VM
+class Repl {
+public:
+    /// Constructor with optional configuration
+    explicit Repl(const ReplConfig& config = {});
+    
+    /// Evaluate an expression, or declarations whose function is then run
+    ReplResult eval(std::string_view input);
+    
+    /// Get the number of inputs evaluated so far
+    size_t get_input_count() const { return input_count_; }
+
+private:
+    ReplConfig config_;
+    Compiler compiler_;
+    VM vm_;
+    Chunk chunk_;                  // Reused so its buffers keep their capacity
+    size_t input_count_ = 0;
+    
+    // Execute chunk_ and format the returned value
+    ReplResult run_chunk();
+};
+
+} // namespace dacite
\ No newline at end of file
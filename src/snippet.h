@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "chunk.h"
+#include "compiler.h"
+#include "source_span.h"
+#include "token.h"
+
+namespace dacite {
+
+/// Constexpr subset of the lexer, parser and compiler for expression snippets.
+///
+/// Accepts the expressions Parser::parse_standalone_expression accepts over
+/// decimal integer literals (+ - * / and comparisons, an optional trailing
+/// ';', whitespace and '//' comments) and emits the same bytecode as
+/// Compiler::compile_standalone_expression without a profile. Code is emitted
+/// while parsing instead of from an AST, so the whole pass can run during
+/// constant evaluation.
+class SnippetCompiler {
+public:
+    constexpr explicit SnippetCompiler(std::string_view source) : source_(source) {}
+
+    /// Compile the snippet; on failure error_message() and error_position() say why
+    constexpr CompileResult compile() {
+        if (!tokenize() || !parse_comparison()) {
+            return CompileResult::ERROR;
+        }
+        match(TokenType::SEMICOLON);
+        if (!check(TokenType::EOF_TOKEN)) {
+            return error("Unexpected token after expression");
+        }
+        emit(OpCode::OP_RETURN, expression_line_);
+        return CompileResult::OK;
+    }
+
+    constexpr const std::vector<uint8_t>& code() const { return code_; }
+    constexpr const std::vector<uint32_t>& lines() const { return lines_; }
+    constexpr const std::vector<int32_t>& constants() const { return constants_; }
+
+    constexpr std::string_view error_message() const { return error_message_; }
+    constexpr SourcePosition error_position() const { return error_position_; }
+    constexpr bool has_errors() const { return !error_message_.empty(); }
+
+private:
+    struct SnippetToken {
+        TokenType type;
+        SourcePosition start;
+        size_t length;
+    };
+
+    std::string_view source_;
+    std::vector<SnippetToken> tokens_;
+    size_t current_ = 0;
+    size_t expression_line_ = 1;
+    std::vector<uint8_t> code_;
+    std::vector<uint32_t> lines_;
+    std::vector<int32_t> constants_;
+    std::string_view error_message_;
+    SourcePosition error_position_;
+
+    // Lexing
+    constexpr bool tokenize() {
+        SourcePosition position;
+        auto advance_to = [&](size_t offset) {
+            position.column += offset - position.offset;
+            position.offset = offset;
+        };
+
+        while (position.offset < source_.size()) {
+            size_t i = position.offset;
+            char c = source_[i];
+
+            if (c == '\n') {
+                position = SourcePosition(position.line + 1, 1, i + 1);
+                continue;
+            }
+            if (c == ' ' || c == '\t' || c == '\r') {
+                advance_to(i + 1);
+                continue;
+            }
+            if (c == '/' && i + 1 < source_.size() && source_[i + 1] == '/') {
+                size_t end = source_.find('\n', i);
+                advance_to(end == std::string_view::npos ? source_.size() : end);
+                continue;
+            }
+
+            size_t length = 1;
+            TokenType type;
+            if (is_digit(c)) {
+                while (i + length < source_.size() && is_digit(source_[i + length])) {
+                    ++length;
+                }
+                if (c == '0' && length > 1) {
+                    return error("Only decimal integer literals are supported in snippets", position);
+                }
+                if (i + length < source_.size() && (source_[i + length] == '.' || is_alpha(source_[i + length]))) {
+                    return error("Only decimal integer literals are supported in snippets", position);
+                }
+                type = TokenType::INTEGER_LITERAL;
+            } else {
+                char next = i + 1 < source_.size() ? source_[i + 1] : '\0';
+                switch (c) {
+                    case '+': type = TokenType::PLUS; break;
+                    case '-': type = TokenType::MINUS; break;
+                    case '*': type = TokenType::MULTIPLY; break;
+                    case '/': type = TokenType::DIVIDE; break;
+                    case ';': type = TokenType::SEMICOLON; break;
+                    case '<': type = next == '=' ? TokenType::LESS_EQUAL : TokenType::LESS_THAN; break;
+                    case '>': type = next == '=' ? TokenType::GREATER_EQUAL : TokenType::GREATER_THAN; break;
+                    case '=': type = next == '=' ? TokenType::EQUAL : TokenType::ERROR; break;
+                    case '!': type = next == '=' ? TokenType::NOT_EQUAL : TokenType::ERROR; break;
+                    default:  type = TokenType::ERROR; break;
+                }
+                if (type == TokenType::ERROR) {
+                    return error("Unsupported character in snippet", position);
+                }
+                if ((c == '<' || c == '>' || c == '=' || c == '!') && next == '=') {
+                    length = 2;
+                }
+            }
+
+            tokens_.push_back({type, position, length});
+            advance_to(i + length);
+        }
+        tokens_.push_back({TokenType::EOF_TOKEN, position, 0});
+        return true;
+    }
+
+    // Token management
+    constexpr const SnippetToken& peek() const { return tokens_[current_]; }
+    constexpr bool check(TokenType type) const { return peek().type == type; }
+
+    constexpr bool match(TokenType type) {
+        if (!check(type)) {
+            return false;
+        }
+        ++current_;
+        return true;
+    }
+
+    // Parsing, emitting each operator after both operands like the compiler's AST walk
+    constexpr bool parse_comparison() {
+        size_t line = peek().start.line;
+        expression_line_ = line;
+        if (!parse_term()) {
+            return false;
+        }
+        while (check(TokenType::EQUAL) || check(TokenType::NOT_EQUAL) ||
+               check(TokenType::LESS_THAN) || check(TokenType::LESS_EQUAL) ||
+               check(TokenType::GREATER_THAN) || check(TokenType::GREATER_EQUAL)) {
+            TokenType operator_type = tokens_[current_++].type;
+            if (!parse_term()) {
+                return false;
+            }
+            emit(binary_opcode(operator_type), line);
+        }
+        return true;
+    }
+
+    constexpr bool parse_term() {
+        size_t line = peek().start.line;
+        if (!parse_factor()) {
+            return false;
+        }
+        while (check(TokenType::PLUS) || check(TokenType::MINUS)) {
+            TokenType operator_type = tokens_[current_++].type;
+            if (!parse_factor()) {
+                return false;
+            }
+            emit(binary_opcode(operator_type), line);
+        }
+        return true;
+    }
+
+    constexpr bool parse_factor() {
+        size_t line = peek().start.line;
+        if (!parse_primary_expression()) {
+            return false;
+        }
+        while (check(TokenType::MULTIPLY) || check(TokenType::DIVIDE)) {
+            TokenType operator_type = tokens_[current_++].type;
+            if (!parse_primary_expression()) {
+                return false;
+            }
+            emit(binary_opcode(operator_type), line);
+        }
+        return true;
+    }
+
+    constexpr bool parse_primary_expression() {
+        const SnippetToken& token = peek();
+        if (token.type != TokenType::INTEGER_LITERAL) {
+            return error("Expected expression", token.start);
+        }
+        ++current_;
+
+        std::string_view digits = source_.substr(token.start.offset, token.length);
+        int64_t value = 0;
+        for (char digit : digits) {
+            value = value * 10 + (digit - '0');
+            if (value > INT32_MAX) {
+                return error("Invalid integer literal", token.start);
+            }
+        }
+
+        if (constants_.size() > 255) {
+            return error("Too many constants", token.start);
+        }
+        constants_.push_back(static_cast<int32_t>(value));
+        emit(OpCode::OP_CONSTANT, token.start.line);
+        emit_byte(static_cast<uint8_t>(constants_.size() - 1), token.start.line);
+        return true;
+    }
+
+    // Code generation
+    constexpr void emit_byte(uint8_t byte, size_t line) {
+        code_.push_back(byte);
+        lines_.push_back(static_cast<uint32_t>(line));
+    }
+
+    constexpr void emit(OpCode opcode, size_t line) {
+        emit_byte(static_cast<uint8_t>(opcode), line);
+    }
+
+    static constexpr OpCode binary_opcode(TokenType type) {
+        switch (type) {
+            case TokenType::PLUS:          return OpCode::OP_ADD;
+            case TokenType::MINUS:         return OpCode::OP_SUBTRACT;
+            case TokenType::MULTIPLY:      return OpCode::OP_MULTIPLY;
+            case TokenType::DIVIDE:        return OpCode::OP_DIVIDE;
+            case TokenType::EQUAL:         return OpCode::OP_EQUAL;
+            case TokenType::NOT_EQUAL:     return OpCode::OP_NOT_EQUAL;
+            case TokenType::LESS_THAN:     return OpCode::OP_LESS;
+            case TokenType::LESS_EQUAL:    return OpCode::OP_LESS_EQUAL;
+            case TokenType::GREATER_THAN:  return OpCode::OP_GREATER;
+            default:                       return OpCode::OP_GREATER_EQUAL;
+        }
+    }
+
+    // Error handling
+    constexpr bool error(std::string_view message, const SourcePosition& position) {
+        error_message_ = message;
+        error_position_ = position;
+        return false;
+    }
+
+    constexpr CompileResult error(std::string_view message) {
+        error(message, peek().start);
+        return CompileResult::ERROR;
+    }
+
+    static constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    static constexpr bool is_alpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+};
+
+/// Snippet source text, usable as a template argument
+template <size_t N>
+struct SnippetSource {
+    char text[N] {};
+
+    consteval SnippetSource(const char (&source)[N]) { std::copy_n(source, N, text); }
+
+    constexpr std::string_view view() const { return std::string_view(text, N - 1); }
+};
+
+/// Bytecode of a snippet compiled during C++ compilation
+template <size_t CodeSize, size_t ConstantCount>
+struct SnippetImage {
+    std::array<uint8_t, CodeSize> code {};
+    std::array<uint32_t, CodeSize> lines {};
+    std::array<int32_t, ConstantCount> constants {};
+
+    /// Replace `chunk`'s contents with this image
+    void load(Chunk& chunk) const {
+        chunk.clear();
+        for (int32_t constant : constants) {
+            chunk.add_constant(Value(constant));
+        }
+        for (size_t i = 0; i < CodeSize; ++i) {
+            chunk.write_byte(code[i], lines[i]);
+        }
+    }
+};
+
+namespace detail {
+
+/// Outcome of compiling a snippet, in a form usable as a template argument
+struct SnippetStatus {
+    char message[64] {};
+    size_t line = 0;            // 0 when the snippet compiled
+    size_t column = 0;
+    size_t code_size = 0;
+    size_t constant_count = 0;
+};
+
+template <SnippetSource Source>
+consteval SnippetStatus snippet_status() {
+    SnippetCompiler compiler(Source.view());
+    SnippetStatus status;
+    if (compiler.compile() != CompileResult::OK) {
+        std::string_view message = compiler.error_message().substr(0, sizeof(status.message) - 1);
+        std::copy(message.begin(), message.end(), status.message);
+        status.line = compiler.error_position().line;
+        status.column = compiler.error_position().column;
+    }
+    status.code_size = compiler.code().size();
+    status.constant_count = compiler.constants().size();
+    return status;
+}
+
+/// Instantiated only for snippets with errors, so the build fails with the
+/// message and position spelled out in the template argument
+template <SnippetStatus Status>
+struct SnippetCompileError {
+    static_assert(Status.line == 0, "dacite snippet does not compile");
+};
+
+} // namespace detail
+
+/// Compile a dacite expression at C++ compile time.
+/// Syntax errors are build errors, and nothing is lexed or parsed at runtime:
+///
+///     constexpr auto answer = dacite::compile_snippet<"6 * 7">();
+///     answer.load(chunk);
+template <SnippetSource Source>
+consteval auto compile_snippet() {
+    constexpr detail::SnippetStatus status = detail::snippet_status<Source>();
+    if constexpr (status.line != 0) {
+        detail::SnippetCompileError<status>{};
+        return SnippetImage<0, 0>{};
+    } else {
+        SnippetCompiler compiler(Source.view());
+        compiler.compile();
+        SnippetImage<status.code_size, status.constant_count> image;
+        std::copy(compiler.code().begin(), compiler.code().end(), image.code.begin());
+        std::copy(compiler.lines().begin(), compiler.lines().end(), image.lines.begin());
+        std::copy(compiler.constants().begin(), compiler.constants().end(), image.constants.begin());
+        return image;
+    }
+}
+
+} // namespace dacite
\ No newline at end of file
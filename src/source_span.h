@@ -10,10 +10,10 @@ struct SourcePosition {
     size_t column;
     size_t offset;
 
-    SourcePosition(size_t line = 1, size_t column = 1, size_t offset = 0)
+    constexpr SourcePosition(size_t line = 1, size_t column = 1, size_t offset = 0)
         : line(line), column(column), offset(offset) {}
 
-    bool operator==(const SourcePosition& other) const {
+    constexpr bool operator==(const SourcePosition& other) const {
         return line == other.line && column == other.column && offset == other.offset;
     }
 };
@@ -0,0 +1,194 @@
+#include "stream_io.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace dacite {
+
+namespace {
+
+std::string_view trim_carriage_return(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+} // namespace
+
+// === OutputBuffer ===
+
+OutputBuffer::OutputBuffer(int fd, size_t capacity)
+    : fd_(fd), buffer_(new char[capacity]), capacity_(capacity) {}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+}
+
+void OutputBuffer::write(std::string_view text) {
+    append(text, {});
+}
+
+void OutputBuffer::write_line(std::string_view text) {
+    append(text, "\n");
+}
+
+void OutputBuffer::append(std::string_view first, std::string_view second) {
+    size_t size = first.size() + second.size();
+    if (used_ + size <= capacity_) {
+        std::memcpy(buffer_.get() + used_, first.data(), first.size());
+        std::memcpy(buffer_.get() + used_ + first.size(), second.data(), second.size());
+        used_ += size;
+        return;
+    }
+    if (size < capacity_ / 2) {
+        // Small writes go through the buffer so the next system call carries more
+        flush();
+        append(first, second);
+        return;
+    }
+    write_out(std::string_view(buffer_.get(), used_), first, second);
+    used_ = 0;
+}
+
+bool OutputBuffer::flush() {
+    if (used_ > 0) {
+        write_out(std::string_view(buffer_.get(), used_), {}, {});
+        used_ = 0;
+    }
+    return !failed_;
+}
+
+bool OutputBuffer::write_out(std::string_view first, std::string_view second, std::string_view third) {
+    iovec parts[3];
+    int count = 0;
+    for (std::string_view part : {first, second, third}) {
+        if (!part.empty()) {
+            parts[count].iov_base = const_cast<char*>(part.data());
+            parts[count].iov_len = part.size();
+            count++;
+        }
+    }
+
+    // Retry short writes from where they stopped
+    iovec* next = parts;
+    while (count > 0 && !failed_) {
+        ssize_t written = count == 1 ? ::write(fd_, next->iov_base, next->iov_len) : ::writev(fd_, next, count);
+        system_calls_++;
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            failed_ = true;
+            break;
+        }
+        auto remaining = static_cast<size_t>(written);
+        while (count > 0 && remaining >= next->iov_len) {
+            remaining -= next->iov_len;
+            next++;
+            count--;
+        }
+        if (count > 0) {
+            next->iov_base = static_cast<char*>(next->iov_base) + remaining;
+            next->iov_len -= remaining;
+        }
+    }
+    return !failed_;
+}
+
+// === LineReader ===
+
+LineReader::LineReader(int fd, size_t capacity) : fd_(fd), buffer_(capacity) {}
+
+std::unique_ptr<LineReader> LineReader::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    std::unique_ptr<LineReader> reader(new LineReader());
+    reader->fd_ = fd;
+    reader->owns_fd_ = true;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            ::madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            reader->mapping_ = static_cast<const char*>(mapping);
+            reader->mapping_size_ = static_cast<size_t>(info.st_size);
+            reader->end_ = reader->mapping_size_;
+            reader->eof_ = true;
+            return reader;
+        }
+    }
+    reader->buffer_.resize(DEFAULT_CAPACITY);
+    return reader;
+}
+
+LineReader::~LineReader() {
+    if (mapping_) {
+        ::munmap(const_cast<char*>(mapping_), mapping_size_);
+    }
+    if (owns_fd_) {
+        ::close(fd_);
+    }
+}
+
+std::optional<std::string_view> LineReader::next_line() {
+    const char* data = mapping_ ? mapping_ : buffer_.data();
+    size_t scanned = begin_;
+    while (true) {
+        if (const void* newline = std::memchr(data + scanned, '\n', end_ - scanned)) {
+            size_t line_end = static_cast<const char*>(newline) - data;
+            std::string_view line(data + begin_, line_end - begin_);
+            begin_ = line_end + 1;
+            return trim_carriage_return(line);
+        }
+        // fill() moves the unread bytes to the front of a possibly larger buffer
+        size_t unread = end_ - begin_;
+        if (eof_ || !fill()) {
+            break;
+        }
+        data = buffer_.data();
+        scanned = begin_ + unread;
+    }
+
+    // The last line may have no newline
+    if (begin_ == end_) {
+        return std::nullopt;
+    }
+    std::string_view line(data + begin_, end_ - begin_);
+    begin_ = end_;
+    return trim_carriage_return(line);
+}
+
+bool LineReader::fill() {
+    // Move the partial line to the front, growing the buffer if it is all line
+    if (begin_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    if (end_ == buffer_.size()) {
+        buffer_.resize(std::max<size_t>(buffer_.size() * 2, 4096));
+    }
+
+    while (true) {
+        ssize_t count = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            eof_ = true;
+            return false;
+        }
+        end_ += static_cast<size_t>(count);
+        return true;
+    }
+}
+
+} // namespace dacite
\ No newline at end of file
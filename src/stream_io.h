@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dacite {
+
+/// Buffered writer over a file descriptor.
+///
+/// Writes collect in one large buffer and leave in a single write() when it
+/// fills or on flush(). Data that does not fit is sent with the buffered
+/// bytes in one writev() instead of being copied in.
+class OutputBuffer {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    /// Buffer writes to `fd`, which stays owned by the caller
+    explicit OutputBuffer(int fd, size_t capacity = DEFAULT_CAPACITY);
+
+    /// Flushes what is left
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /// Append `text`
+    void write(std::string_view text);
+
+    /// Append `text` and a newline
+    void write_line(std::string_view text);
+
+    /// Write out everything buffered; false once any write has failed
+    bool flush();
+
+    /// Check that no write has failed
+    bool ok() const { return !failed_; }
+
+    /// Number of write()/writev() calls made so far
+    uint64_t system_calls() const { return system_calls_; }
+
+private:
+    int fd_;
+    std::unique_ptr<char[]> buffer_;
+    size_t capacity_;
+    size_t used_ = 0;
+    bool failed_ = false;
+    uint64_t system_calls_ = 0;
+
+    void append(std::string_view first, std::string_view second);
+    bool write_out(std::string_view first, std::string_view second, std::string_view third);
+};
+
+/// Line reader handing out views of its buffer instead of copies.
+///
+/// Regular files are memory-mapped, so every line stays valid for the
+/// reader's lifetime. Other descriptors (pipes, terminals) are read through a
+/// buffer that grows to fit the longest line; their lines stay valid until the
+/// next call to next_line().
+class LineReader {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    /// Read from `fd` through a buffer; the descriptor stays owned by the caller
+    explicit LineReader(int fd, size_t capacity = DEFAULT_CAPACITY);
+
+    /// Map the file at `path`, falling back to buffered reads if it cannot be mapped.
+    /// Returns nullptr if the file cannot be opened.
+    static std::unique_ptr<LineReader> open(const std::string& path);
+
+    ~LineReader();
+
+    LineReader(const LineReader&) = delete;
+    LineReader& operator=(const LineReader&) = delete;
+
+    /// The next line without its '\n' (or "\r\n"), or nullopt at end of input
+    std::optional<std::string_view> next_line();
+
+    /// Check if lines are views of a mapping that lives as long as the reader
+    bool is_mapped() const { return mapping_ != nullptr; }
+
+private:
+    int fd_;
+    bool owns_fd_ = false;
+    const char* mapping_ = nullptr;   // Whole file when mapped
+    size_t mapping_size_ = 0;
+    std::vector<char> buffer_;        // Buffered mode
+    size_t begin_ = 0;                // Unread bytes are [begin_, end_)
+    size_t end_ = 0;
+    bool eof_ = false;
+
+    LineReader() = default;
+    bool fill();
+};
+
+} // namespace dacite
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "string_kernels.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace dacite::text {
+
+namespace {
+
+#if defined(__SSE2__)
+constexpr size_t BLOCK = 16;
+
+__m128i load(const char* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+/// Turn the ASCII upper-case letters in `block` lower case
+__m128i fold_case(__m128i block) {
+    // Bytes of 0x80 and above compare as negative, so they are never letters
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(block, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+char fold_case(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+bool is_continuation(unsigned char byte) {
+    return (byte & 0xC0) == 0x80;
+}
+
+} // namespace
+
+size_t ascii_prefix_length(std::string_view text) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Two blocks per step; the byte-wise OR keeps every high bit
+    for (; i + 2 * BLOCK <= text.size(); i += 2 * BLOCK) {
+        __m128i both = _mm_or_si128(load(text.data() + i), load(text.data() + i + BLOCK));
+        if (_mm_movemask_epi8(both) != 0) {
+            break;
+        }
+    }
+#endif
+    while (i < text.size() && static_cast<unsigned char>(text[i]) < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+size_t count_code_points(std::string_view text) {
+    size_t continuations = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Continuation bytes 0x80-0xBF are the signed bytes below -64
+    const __m128i limit = _mm_set1_epi8(-64);
+    for (; i + BLOCK <= text.size(); i += BLOCK) {
+        __m128i below = _mm_cmplt_epi8(load(text.data() + i), limit);
+        continuations += std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(below)));
+    }
+#endif
+    for (; i < text.size(); ++i) {
+        continuations += is_continuation(static_cast<unsigned char>(text[i]));
+    }
+    return text.size() - continuations;
+}
+
+CodePoint decode_utf8(std::string_view text, size_t offset) {
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data()) + offset;
+    size_t available = text.size() - offset;
+    unsigned char lead = data[0];
+    if (lead < 0x80) {
+        return {lead, 1};
+    }
+    
+    size_t length;
+    char32_t value;
+    unsigned char second_min = 0x80;
+    unsigned char second_max = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        value = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        value = lead & 0x0F;
+        if (lead == 0xE0) second_min = 0xA0;  // Overlong
+        if (lead == 0xED) second_max = 0x9F;  // Surrogates
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        value = lead & 0x07;
+        if (lead == 0xF0) second_min = 0x90;  // Overlong
+        if (lead == 0xF4) second_max = 0x8F;  // Past U+10FFFF
+    } else {
+        return {0, 0};
+    }
+    
+    if (available < length || data[1] < second_min || data[1] > second_max) {
+        return {0, 0};
+    }
+    for (size_t k = 1; k < length; ++k) {
+        if (!is_continuation(data[k])) {
+            return {0, 0};
+        }
+        value = (value << 6) | (data[k] & 0x3F);
+    }
+    return {value, length};
+}
+
+size_t find(std::string_view haystack, std::string_view needle) {
+    if (needle.empty()) {
+        return 0;
+    }
+    if (needle.size() > haystack.size()) {
+        return std::string_view::npos;
+    }
+    if (needle.size() == 1) {
+        const void* match = std::memchr(haystack.data(), needle[0], haystack.size());
+        return match ? static_cast<const char*>(match) - haystack.data() : std::string_view::npos;
+    }
+
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Candidates are positions where both the first and last needle bytes match;
+    // only those are compared in full
+    const size_t last = needle.size() - 1;
+    const __m128i first_byte = _mm_set1_epi8(needle[0]);
+    const __m128i last_byte = _mm_set1_epi8(needle[last]);
+    for (; i + last + BLOCK <= haystack.size(); i += BLOCK) {
+        __m128i firsts = _mm_cmpeq_epi8(first_byte, load(haystack.data() + i));
+        __m128i lasts = _mm_cmpeq_epi8(last_byte, load(haystack.data() + i + last));
+        auto candidates = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(firsts, lasts)));
+        while (candidates != 0) {
+            size_t offset = i + std::countr_zero(candidates);
+            if (std::memcmp(haystack.data() + offset + 1, needle.data() + 1, last - 1) == 0) {
+                return offset;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+#endif
+    size_t rest = haystack.substr(i).find(needle);
+    return rest == std::string_view::npos ? rest : i + rest;
+}
+
+size_t count_byte(std::string_view text, char byte) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i target = _mm_set1_epi8(byte);
+    for (; i + BLOCK <= text.size(); i += BLOCK) {
+        auto matches = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(target, load(text.data() + i))));
+        count += std::popcount(matches);
+    }
+#endif
+    for (; i < text.size(); ++i) {
+        count += text[i] == byte;
+    }
+    return count;
+}
+
+size_t count_lines(std::string_view text) {
+    size_t lines = count_byte(text, '\n');
+    if (!text.empty() && text.back() != '\n') {
+        lines++;
+    }
+    return lines;
+}
+
+bool equals_ignore_case(std::string_view left, std::string_view right) {
+    if (left.size() != right.size()) {
+        return false;
+    }
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + BLOCK <= left.size(); i += BLOCK) {
+        __m128i equal = _mm_cmpeq_epi8(fold_case(load(left.data() + i)), fold_case(load(right.data() + i)));
+        if (_mm_movemask_epi8(equal) != 0xFFFF) {
+            return false;
+        }
+    }
+#endif
+    for (; i < left.size(); ++i) {
+        if (fold_case(left[i]) != fold_case(right[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool is_valid_utf8(std::string_view text) {
+    size_t i = 0;
+    while (i < text.size()) {
+        // Only bytes with the high bit set need decoding
+        i += ascii_prefix_length(text.substr(i));
+        if (i == text.size()) {
+            break;
+        }
+        size_t length = decode_utf8(text, i).length;
+        if (length == 0) {
+            return false;
+        }
+        i += length;
+    }
+    return true;
+}
+
+std::optional<std::string_view> split_field(std::string_view text, std::string_view separator, size_t index) {
+    if (separator.empty()) {
+        return std::nullopt;
+    }
+    size_t start = 0;
+    for (size_t field = 0; field < index; ++field) {
+        size_t end = find(text.substr(start), separator);
+        if (end == std::string_view::npos) {
+            return std::nullopt;
+        }
+        start += end + separator.size();
+    }
+    size_t end = find(text.substr(start), separator);
+    return text.substr(start, end);
+}
+
+} // namespace dacite::text
\ No newline at end of file
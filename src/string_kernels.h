@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace dacite::text {
+
+/// Byte-level string kernels behind the string builtins and the lexer.
+///
+/// Each scans 16 bytes at a time with SSE2 where available and falls back to
+/// scalar code for the tail and on other targets. Results that are pieces of
+/// the input are views into it.
+
+/// Byte offset of the first occurrence of `needle`, or npos. An empty needle is found at 0.
+size_t find(std::string_view haystack, std::string_view needle);
+
+/// Number of bytes equal to `byte`
+size_t count_byte(std::string_view text, char byte);
+
+/// Number of lines; a final line without '\n' counts, an empty string has none
+size_t count_lines(std::string_view text);
+
+/// Compare with ASCII letters folded to lower case; other bytes must match exactly
+bool equals_ignore_case(std::string_view left, std::string_view right);
+
+/// Number of leading ASCII bytes, checked 32 at a time
+size_t ascii_prefix_length(std::string_view text);
+
+/// Number of code points in well-formed UTF-8 (bytes that are not continuation bytes)
+size_t count_code_points(std::string_view text);
+
+/// A code point decoded from UTF-8; `length` is 0 for an ill-formed sequence
+struct CodePoint {
+    char32_t value;
+    size_t length;
+};
+
+/// Decode the code point starting at `offset`, which must be in range
+CodePoint decode_utf8(std::string_view text, size_t offset);
+
+/// Check that `text` is well-formed UTF-8 (no overlong forms, surrogates or code points past U+10FFFF)
+bool is_valid_utf8(std::string_view text);
+
+/// The `index`-th piece of `text` split at every `separator`, or nullopt if there are
+/// fewer pieces or the separator is empty
+std::optional<std::string_view> split_field(std::string_view text, std::string_view separator, size_t index);
+
+} // namespace dacite::text
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "string_object.h"
+
+namespace dacite {
+
+StringObject::StringObject(std::string text, bool is_static)
+    : storage_(std::move(text)), view_(storage_), static_(is_static) {}
+
+StringObject::StringObject(std::string_view view) : view_(view) {}
+
+StringObject::~StringObject() {
+    if (parent_) {
+        parent_->release();
+    }
+}
+
+StringObject* StringObject::make(std::string text) {
+    return new StringObject(std::move(text), false);
+}
+
+StringObject* StringObject::make_view(std::string_view text) {
+    return new StringObject(text);
+}
+
+StringObject* StringObject::make_slice(StringObject* parent, std::string_view part) {
+    auto* slice = new StringObject(part);
+    parent->retain();
+    slice->parent_ = parent;
+    return slice;
+}
+
+std::unique_ptr<StringObject> StringObject::make_static(std::string text) {
+    return std::unique_ptr<StringObject>(new StringObject(std::move(text), true));
+}
+
+bool StringObject::borrows_static() const {
+    const StringObject* object = this;
+    while (object->parent_) {
+        object = object->parent_;
+    }
+    return object->static_;
+}
+
+void StringRef::append(std::string_view text) {
+    if (object_ && object_->is_unique()) {
+        object_->append(text);
+        return;
+    }
+    std::string joined;
+    joined.reserve(view().size() + text.size());
+    joined.append(view()).append(text);
+    *this = make(std::move(joined));
+}
+
+} // namespace dacite
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace dacite {
+
+/// Immutable text shared by string values.
+///
+/// A string either owns its bytes or views memory owned elsewhere (a chunk's
+/// constant pool, a mapped input file, another string it is a slice of), so
+/// handing text to the VM never has to copy it. References are counted with a
+/// plain integer: string values belong to one VM, and strings shared between
+/// threads (chunk constants) are static and not counted at all. The VM copies
+/// values that still borrow a static string when a run returns.
+class StringObject {
+public:
+    /// New string owning `text`, with one reference
+    static StringObject* make(std::string text);
+
+    /// New string viewing `text`, with one reference; the memory must outlive every reference
+    static StringObject* make_view(std::string_view text);
+
+    /// New string viewing `part` of `parent`, with one reference; keeps `parent` alive
+    static StringObject* make_slice(StringObject* parent, std::string_view part);
+    
+    /// Uncounted string owned by the caller, e.g. a chunk's constant pool
+    static std::unique_ptr<StringObject> make_static(std::string text);
+
+    ~StringObject();
+    StringObject(const StringObject&) = delete;
+    StringObject& operator=(const StringObject&) = delete;
+
+    std::string_view view() const { return view_; }
+
+    /// Check if this string's lifetime is managed by its owner rather than counted
+    bool is_static() const { return static_; }
+    
+    /// Check if this string is static or a slice of one, so it must not outlive the static string's owner
+    bool borrows_static() const;
+
+    uint32_t ref_count() const { return refs_; }
+    
+    /// Check if this string owns its bytes and has no other reference, so it can change in place
+    bool is_unique() const { return !static_ && refs_ == 1 && view_.data() == storage_.data(); }
+    
+    /// Append to a unique string; growth is geometric, so repeated appends are amortized O(1) per byte
+    void append(std::string_view text) {
+        storage_.append(text);
+        view_ = storage_;
+    }
+
+    void retain() {
+        if (!static_) ++refs_;
+    }
+
+    void release() {
+        if (!static_ && --refs_ == 0) delete this;
+    }
+
+private:
+    StringObject(std::string text, bool is_static);
+    explicit StringObject(std::string_view view);
+
+    std::string storage_;      // Empty for views
+    std::string_view view_;    // The text, in storage_ or elsewhere
+    StringObject* parent_ = nullptr; // Retained by slices
+    uint32_t refs_ = 1;
+    bool static_ = false;
+};
+
+/// Counted reference to a StringObject
+class StringRef {
+public:
+    StringRef() = default;
+
+    /// Take over a reference the caller already holds (as returned by StringObject::make)
+    explicit StringRef(StringObject* object) : object_(object) {}
+
+    /// New owned string
+    static StringRef make(std::string text) { return StringRef(StringObject::make(std::move(text))); }
+
+    StringRef(const StringRef& other) : object_(other.object_) {
+        if (object_) object_->retain();
+    }
+
+    StringRef(StringRef&& other) noexcept : object_(other.object_) {
+        other.object_ = nullptr;
+    }
+
+    StringRef& operator=(StringRef other) noexcept {
+        std::swap(object_, other.object_);
+        return *this;
+    }
+
+    ~StringRef() {
+        if (object_) object_->release();
+    }
+
+    /// Append `text` in place when this is the only reference to an owned string,
+    /// otherwise point this reference at a new string holding both
+    void append(std::string_view text);
+    
+    std::string_view view() const { return object_ ? object_->view() : std::string_view(); }
+    StringObject* get() const { return object_; }
+
+    /// Strings compare by content
+    bool operator==(const StringRef& other) const { return view() == other.view(); }
+
+private:
+    StringObject* object_ = nullptr;
+};
+
+} // namespace dacite
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bit>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include "source_span.h"
@@ -76,20 +78,32 @@ enum class TokenType {
     ERROR
 };
 
-/// Represents a single token with its type, value, and source location
+/// Represents a single token with its type, value, and source location.
+///
+/// Numeric literals also carry the value the lexer decoded, as raw bits so the
+/// token stays trivially movable apart from its string: the integer itself for
+/// INTEGER_LITERAL, the double's bit pattern for FLOAT_LITERAL, 0 otherwise.
 struct Token {
     TokenType type;
     std::string value;
     SourceSpan span;
+    uint64_t literal_bits = 0;
 
-    Token(TokenType type, std::string value, const SourceSpan& span)
-        : type(type), value(std::move(value)), span(span) {}
+    Token(TokenType type, std::string value, const SourceSpan& span, uint64_t literal_bits = 0)
+        : type(type), value(std::move(value)), span(span), literal_bits(literal_bits) {}
 
     Token(TokenType type, const SourceSpan& span)
         : type(type), value(), span(span) {}
 
+    /// Decoded value of an INTEGER_LITERAL
+    uint64_t integer_value() const { return literal_bits; }
+
+    /// Decoded value of a FLOAT_LITERAL
+    double float_value() const { return std::bit_cast<double>(literal_bits); }
+
     bool operator==(const Token& other) const {
-        return type == other.type && value == other.value && span == other.span;
+        return type == other.type && value == other.value && span == other.span &&
+               literal_bits == other.literal_bits;
     }
 };
 
@@ -0,0 +1,183 @@
+#include "token_buffer.h"
+#include "string_kernels.h"
+#include <algorithm>
+#include <bit>
+
+namespace dacite {
+
+TokenBuffer::TokenBuffer(std::string_view source, std::pmr::memory_resource* resource)
+    : source_(source), types_(resource), offsets_(resource), lengths_(resource)
+    , long_lengths_(resource), values_(resource), value_chars_(resource), numbers_(resource)
+    , spans_(resource), line_starts_(resource), block_columns_(resource) {
+    index_lines();
+}
+
+void TokenBuffer::clear(std::string_view source) {
+    source_ = source;
+    types_.clear();
+    offsets_.clear();
+    lengths_.clear();
+    long_lengths_.clear();
+    values_.clear();
+    value_chars_.clear();
+    numbers_.clear();
+    spans_.clear();
+    index_lines();
+}
+
+void TokenBuffer::reserve(size_t count) {
+    types_.reserve(count);
+    offsets_.reserve(count);
+    lengths_.reserve(count);
+    if (detached()) {
+        spans_.reserve(count);
+    }
+}
+
+void TokenBuffer::push_back(const Token& token) {
+    auto index = static_cast<uint32_t>(types_.size());
+    size_t offset = token.span.start.offset;
+    size_t token_length = token.span.end.offset - offset;
+
+    types_.push_back(static_cast<uint8_t>(token.type));
+    offsets_.push_back(static_cast<uint32_t>(offset));
+    if (token_length < LONG_LENGTH) {
+        lengths_.push_back(static_cast<uint16_t>(token_length));
+    } else {
+        lengths_.push_back(LONG_LENGTH);
+        long_lengths_.push_back({index, 0, static_cast<uint32_t>(token_length)});
+    }
+
+    // Only values that value() cannot recover from the source go to the side table
+    std::string_view recovered;
+    if (detached()) {
+        spans_.push_back(token.span);
+    } else if (value_is_lexeme(token.type) && offset + token_length <= source_.size()) {
+        recovered = source_.substr(offset, token_length);
+    }
+    if (token.value != recovered) {
+        values_.push_back({index, static_cast<uint32_t>(value_chars_.size()),
+                           static_cast<uint32_t>(token.value.size())});
+        value_chars_.insert(value_chars_.end(), token.value.begin(), token.value.end());
+    }
+    if (token.type == TokenType::INTEGER_LITERAL || token.type == TokenType::FLOAT_LITERAL) {
+        numbers_.push_back({index, token.literal_bits});
+    }
+}
+
+std::string_view TokenBuffer::value(size_t index) const {
+    if (index >= size()) {
+        return {};
+    }
+    if (const SideEntry* entry = find(values_, index)) {
+        return std::string_view(value_chars_.data() + entry->offset, entry->length);
+    }
+    if (detached() || !value_is_lexeme(type(index))) {
+        return {};
+    }
+    return source_.substr(offsets_[index], length(index));
+}
+
+uint64_t TokenBuffer::integer_value(size_t index) const {
+    return type(index) == TokenType::INTEGER_LITERAL ? literal_bits(index) : 0;
+}
+
+double TokenBuffer::float_value(size_t index) const {
+    return type(index) == TokenType::FLOAT_LITERAL ? std::bit_cast<double>(literal_bits(index)) : 0.0;
+}
+
+SourceSpan TokenBuffer::span(size_t index) const {
+    if (index >= size()) {
+        return {};
+    }
+    if (detached()) {
+        return spans_[index];
+    }
+    size_t start = offsets_[index];
+    return SourceSpan(position_at(start), position_at(start + length(index)));
+}
+
+Token TokenBuffer::token(size_t index) const {
+    TokenType token_type = type(index);
+    bool is_number = token_type == TokenType::INTEGER_LITERAL || token_type == TokenType::FLOAT_LITERAL;
+    return Token(token_type, std::string(value(index)), span(index), is_number ? literal_bits(index) : 0);
+}
+
+size_t TokenBuffer::length(size_t index) const {
+    if (lengths_[index] != LONG_LENGTH) {
+        return lengths_[index];
+    }
+    return find(long_lengths_, index)->length;
+}
+
+void TokenBuffer::index_lines() {
+    line_starts_.clear();
+    line_starts_.push_back(0);
+    for (size_t i = source_.find('\n'); i != std::string_view::npos; i = source_.find('\n', i + 1)) {
+        line_starts_.push_back(static_cast<uint32_t>(i + 1));
+    }
+    ascii_source_ = text::ascii_prefix_length(source_) == source_.size();
+    
+    // Code point columns at every block start, so a position never decodes more than one block
+    block_columns_.clear();
+    if (ascii_source_) {
+        return;
+    }
+    size_t column = 0;
+    for (size_t start = 0; start <= source_.size(); start += COLUMN_BLOCK) {
+        block_columns_.push_back(static_cast<uint32_t>(column));
+        std::string_view block = source_.substr(start, COLUMN_BLOCK);
+        size_t last_newline = block.rfind('\n');
+        if (last_newline == std::string_view::npos) {
+            column += text::count_code_points(block);
+        } else {
+            column = text::count_code_points(block.substr(last_newline + 1));
+        }
+    }
+}
+
+SourcePosition TokenBuffer::position_at(size_t offset) const {
+    auto line = std::upper_bound(line_starts_.begin(), line_starts_.end(), offset) - line_starts_.begin();
+    size_t line_start = line_starts_[line - 1];
+    
+    // Columns count code points, like the lexer's; only non-ASCII sources need decoding,
+    // from the line start or the offset's block start, whichever is later
+    size_t column = offset - line_start;
+    if (!ascii_source_) {
+        size_t block_start = offset - offset % COLUMN_BLOCK;
+        if (block_start > line_start) {
+            column = block_columns_[block_start / COLUMN_BLOCK] +
+                     text::count_code_points(source_.substr(block_start, offset - block_start));
+        } else {
+            column = text::count_code_points(source_.substr(line_start, column));
+        }
+    }
+    return SourcePosition(static_cast<size_t>(line), column + 1, offset);
+}
+
+bool TokenBuffer::value_is_lexeme(TokenType type) {
+    switch (type) {
+        case TokenType::IDENTIFIER:
+        case TokenType::INTEGER_LITERAL:
+        case TokenType::FLOAT_LITERAL:
+        case TokenType::SINGLE_LINE_COMMENT:
+        case TokenType::WHITESPACE:
+            return true;
+        default:
+            return is_keyword(type);
+    }
+}
+
+uint64_t TokenBuffer::literal_bits(size_t index) const {
+    const NumberEntry* entry = find(numbers_, index);
+    return entry ? entry->bits : 0;
+}
+
+template <typename Entry>
+const Entry* TokenBuffer::find(const std::pmr::vector<Entry>& table, size_t index) {
+    auto it = std::lower_bound(table.begin(), table.end(), index,
+                               [](const Entry& entry, size_t i) { return entry.index < i; });
+    return it != table.end() && it->index == index ? &*it : nullptr;
+}
+
+} // namespace dacite
\ No newline at end of file
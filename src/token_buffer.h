@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+#include "token.h"
+#include "source_span.h"
+
+namespace dacite {
+
+/// Struct-of-arrays token stream.
+///
+/// The hot data is a dense array of one-byte token types next to arrays of
+/// source offsets and lengths (7 bytes per token), so scanning types touches
+/// nothing else. Lexemes are slices of the source, positions are decoded on
+/// demand from a line table built when the source is set, and the few values
+/// that are not plain slices (unescaped literals, error messages) live in a
+/// side table. Numeric literals keep the binary value the lexer decoded in a
+/// second one.
+///
+/// A buffer built without source text (from already materialized tokens)
+/// keeps every value and span in the side tables instead.
+///
+/// Const member functions do not modify the buffer, so a filled buffer can be
+/// read from several threads at once.
+class TokenBuffer {
+public:
+    /// Create an empty buffer over `source`, which must outlive it
+    explicit TokenBuffer(std::string_view source = {},
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /// Drop all tokens and switch to new source, keeping the arrays' capacity
+    void clear(std::string_view source = {});
+
+    /// Reserve room for `count` tokens in the per-token arrays
+    void reserve(size_t count);
+
+    /// Append a token produced from this buffer's source (or any token when there is none)
+    void push_back(const Token& token);
+
+    /// Number of tokens
+    size_t size() const { return types_.size(); }
+    bool empty() const { return types_.empty(); }
+
+    /// Token type; indices past the end read as EOF_TOKEN
+    TokenType type(size_t index) const {
+        return index < types_.size() ? static_cast<TokenType>(types_[index]) : TokenType::EOF_TOKEN;
+    }
+
+    /// The token's value, as Token::value would hold it
+    std::string_view value(size_t index) const;
+
+    /// Decoded value of an INTEGER_LITERAL token (0 for other tokens)
+    uint64_t integer_value(size_t index) const;
+
+    /// Decoded value of a FLOAT_LITERAL token (0.0 for other tokens)
+    double float_value(size_t index) const;
+
+    /// The token's source span, decoded from its offset
+    SourceSpan span(size_t index) const;
+
+    /// Materialize a full token
+    Token token(size_t index) const;
+
+    /// Bytes held by the per-token arrays, excluding spare capacity and side tables
+    size_t token_bytes() const { return size() * (sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint16_t)); }
+
+private:
+    // Lengths that do not fit in 16 bits are stored here, marked by LONG_LENGTH
+    static constexpr uint16_t LONG_LENGTH = UINT16_MAX;
+
+    // Spacing of the column checkpoints kept for non-ASCII sources
+    static constexpr size_t COLUMN_BLOCK = 64;
+
+    /// Side table entry, sorted by token index
+    struct SideEntry {
+        uint32_t index;
+        uint32_t offset;    // Into value_chars_
+        uint32_t length;
+    };
+
+    /// Token::literal_bits of a numeric literal, sorted by token index
+    struct NumberEntry {
+        uint32_t index;
+        uint64_t bits;
+    };
+
+    std::string_view source_;
+    std::pmr::vector<uint8_t> types_;
+    std::pmr::vector<uint32_t> offsets_;
+    std::pmr::vector<uint16_t> lengths_;
+    std::pmr::vector<SideEntry> long_lengths_;
+    std::pmr::vector<SideEntry> values_;
+    std::pmr::vector<char> value_chars_;
+    std::pmr::vector<NumberEntry> numbers_;
+    std::pmr::vector<SourceSpan> spans_;                  // Per token, only for buffers without source
+    std::pmr::vector<uint32_t> line_starts_;              // Offset of each line, built with source_
+    bool ascii_source_ = true;                            // Columns are byte offsets; set with line_starts_
+    std::pmr::vector<uint32_t> block_columns_;            // Non-ASCII only: code points from the line start to each block
+
+    bool detached() const { return source_.empty(); }
+    void index_lines();
+    size_t length(size_t index) const;
+    SourcePosition position_at(size_t offset) const;
+    static bool value_is_lexeme(TokenType type);
+    uint64_t literal_bits(size_t index) const;
+    template <typename Entry>
+    static const Entry* find(const std::pmr::vector<Entry>& table, size_t index);
+};
+
+} // namespace dacite
\ No newline at end of file
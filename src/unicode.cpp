@@ -0,0 +1,307 @@
+#include "unicode.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace dacite::unicode {
+
+namespace {
+
+// Non-ASCII code points only; ASCII is classified without the tables.
+// Each entry is (first << 11) | (count - 1) for a range of code points.
+// Unicode 14.0.0, generated by tools/gen_unicode_tables.py
+constexpr uint32_t XID_START[] = {
+    0x00055000, 0x0005A800, 0x0005D000, 0x00060016, 0x0006C01E, 0x0007C1C9,
+    0x0016300B, 0x00170004, 0x00176000, 0x00177000, 0x001B8004, 0x001BB001,
+    0x001BD802, 0x001BF800, 0x001C3000, 0x001C4002, 0x001C6000, 0x001C7013,
+    0x001D1852, 0x001FB88A, 0x002450A5, 0x00298825, 0x002AC800, 0x002B0028,
+    0x002E801A, 0x002F7803, 0x0031002A, 0x00337001, 0x00338862, 0x0036A800,
+    0x00372801, 0x00377001, 0x0037D002, 0x0037F800, 0x00388000, 0x0038901D,
+    0x003A6858, 0x003D8800, 0x003E5020, 0x003FA001, 0x003FD000, 0x00400015,
+    0x0040D000, 0x00412000, 0x00414000, 0x00420018, 0x0043000A, 0x00438017,
+    0x00444805, 0x00450029, 0x00482035, 0x0049E800, 0x004A8000, 0x004AC009,
+    0x004B880F, 0x004C2807, 0x004C7801, 0x004C9815, 0x004D5006, 0x004D9000,
+    0x004DB003, 0x004DE800, 0x004E7000, 0x004EE001, 0x004EF802, 0x004F8001,
+    0x004FE000, 0x00502805, 0x00507801, 0x00509815, 0x00515006, 0x00519001,
+    0x0051A801, 0x0051C001, 0x0052C803, 0x0052F000, 0x00539002, 0x00542808,
+    0x00547802, 0x00549815, 0x00555006, 0x00559001, 0x0055A804, 0x0055E800,
+    0x00568000, 0x00570001, 0x0057C800, 0x00582807, 0x00587801, 0x00589815,
+    0x00595006, 0x00599001, 0x0059A804, 0x0059E800, 0x005AE001, 0x005AF802,
+    0x005B8800, 0x005C1800, 0x005C2805, 0x005C7002, 0x005C9003, 0x005CC801,
+    0x005CE000, 0x005CF001, 0x005D1801, 0x005D4002, 0x005D700B, 0x005E8000,
+    0x00602807, 0x00607002, 0x00609016, 0x0061500F, 0x0061E800, 0x0062C002,
+    0x0062E800, 0x00630001, 0x00640000, 0x00642807, 0x00647002, 0x00649016,
+    0x00655009, 0x0065A804, 0x0065E800, 0x0066E801, 0x00670001, 0x00678801,
+    0x00682008, 0x00687002, 0x00689028, 0x0069E800, 0x006A7000, 0x006AA002,
+    0x006AF802, 0x006BD005, 0x006C2811, 0x006CD017, 0x006D9808, 0x006DE800,
+    0x006E0006, 0x0070082F, 0x00719000, 0x00720006, 0x00740801, 0x00742000,
+    0x00743004, 0x00746017, 0x00752800, 0x00753809, 0x00759000, 0x0075E800,
+    0x00760004, 0x00763000, 0x0076E003, 0x00780000, 0x007A0007, 0x007A4823,
+    0x007C4004, 0x0080002A, 0x0081F800, 0x00828005, 0x0082D003, 0x00830800,
+    0x00832801, 0x00837002, 0x0083A80C, 0x00847000, 0x00850025, 0x00863800,
+    0x00866800, 0x0086802A, 0x0087E14C, 0x00925003, 0x00928006, 0x0092C000,
+    0x0092D003, 0x00930028, 0x00945003, 0x00948020, 0x00959003, 0x0095C006,
+    0x00960000, 0x00961003, 0x0096400E, 0x0096C038, 0x00989003, 0x0098C042,
+    0x009C000F, 0x009D0055, 0x009FC005, 0x00A00A6B, 0x00B37810, 0x00B40819,
+    0x00B5004A, 0x00B7700A, 0x00B80011, 0x00B8F812, 0x00BA0011, 0x00BB000C,
+    0x00BB7002, 0x00BC0033, 0x00BEB800, 0x00BEE000, 0x00C10058, 0x00C40028,
+    0x00C55000, 0x00C58045, 0x00C8001E, 0x00CA801D, 0x00CB8004, 0x00CC002B,
+    0x00CD8019, 0x00D00016, 0x00D10034, 0x00D53800, 0x00D8282E, 0x00DA2807,
+    0x00DC181D, 0x00DD7001, 0x00DDD02B, 0x00E00023, 0x00E26802, 0x00E2D023,
+    0x00E40008, 0x00E4802A, 0x00E5E802, 0x00E74803, 0x00E77005, 0x00E7A801,
+    0x00E7D000, 0x00E800BF, 0x00F00115, 0x00F8C005, 0x00F90025, 0x00FA4005,
+    0x00FA8007, 0x00FAC800, 0x00FAD800, 0x00FAE800, 0x00FAF81E, 0x00FC0034,
+    0x00FDB006, 0x00FDF000, 0x00FE1002, 0x00FE3006, 0x00FE8003, 0x00FEB005,
+    0x00FF000C, 0x00FF9002, 0x00FFB006, 0x01038800, 0x0103F800, 0x0104800C,
+    0x01081000, 0x01083800, 0x01085009, 0x0108A800, 0x0108C005, 0x01092000,
+    0x01093000, 0x01094000, 0x0109500F, 0x0109E003, 0x010A2804, 0x010A7000,
+    0x010B0028, 0x016000E4, 0x01675803, 0x01679001, 0x01680025, 0x01693800,
+    0x01696800, 0x01698037, 0x016B7800, 0x016C0016, 0x016D0006, 0x016D4006,
+    0x016D8006, 0x016DC006, 0x016E0006, 0x016E4006, 0x016E8006, 0x016EC006,
+    0x01802802, 0x01810808, 0x01818804, 0x0181C004, 0x01820855, 0x0184E802,
+    0x01850859, 0x0187E003, 0x0188282A, 0x0189885D, 0x018D001F, 0x018F800F,
+    0x01A007FF, 0x01E007FF, 0x022007FF, 0x026001BF, 0x027007FF, 0x02B007FF,
+    0x02F007FF, 0x033007FF, 0x037007FF, 0x03B007FF, 0x03F007FF, 0x043007FF,
+    0x047007FF, 0x04B007FF, 0x04F0068C, 0x0526802D, 0x0528010C, 0x0530800F,
+    0x05315001, 0x0532002E, 0x0533F81E, 0x0535004F, 0x0538B808, 0x05391066,
+    0x053C583F, 0x053E8001, 0x053E9800, 0x053EA804, 0x053F900F, 0x05401802,
+    0x05403803, 0x05406016, 0x05420033, 0x05441031, 0x05479005, 0x0547D800,
+    0x0547E801, 0x0548501B, 0x05498016, 0x054B001C, 0x054C202E, 0x054E7800,
+    0x054F0004, 0x054F3009, 0x054FD004, 0x05500028, 0x05520002, 0x05522007,
+    0x05530016, 0x0553D000, 0x0553F031, 0x05558800, 0x0555A801, 0x0555C804,
+    0x05560000, 0x05561000, 0x0556D802, 0x0557000A, 0x05579002, 0x05580805,
+    0x05584805, 0x05588805, 0x05590006, 0x05594006, 0x0559802A, 0x055AE00D,
+    0x055B8072, 0x056007FF, 0x05A007FF, 0x05E007FF, 0x062007FF, 0x066007FF,
+    0x06A003A3, 0x06BD8016, 0x06BE5830, 0x07C8016D, 0x07D38069, 0x07D80006,
+    0x07D89804, 0x07D8E800, 0x07D8F809, 0x07D9500C, 0x07D9C004, 0x07D9F000,
+    0x07DA0001, 0x07DA1801, 0x07DA306B, 0x07DE988A, 0x07E320D9, 0x07EA803F,
+    0x07EC9035, 0x07EF8009, 0x07F38800, 0x07F39800, 0x07F3B800, 0x07F3C800,
+    0x07F3D800, 0x07F3E800, 0x07F3F87D, 0x07F90819, 0x07FA0819, 0x07FB3037,
+    0x07FD001E, 0x07FE1005, 0x07FE5005, 0x07FE9005, 0x07FED002, 0x0800000B,
+    0x08006819, 0x08014012, 0x0801E001, 0x0801F80E, 0x0802800D, 0x0804007A,
+    0x080A0034, 0x0814001C, 0x08150030, 0x0818001F, 0x0819681D, 0x081A8025,
+    0x081C001D, 0x081D0023, 0x081E4007, 0x081E8804, 0x0820009D, 0x08258023,
+    0x0826C023, 0x08280027, 0x08298033, 0x082B800A, 0x082BE00E, 0x082C6006,
+    0x082CA001, 0x082CB80A, 0x082D180E, 0x082D9806, 0x082DD801, 0x08300136,
+    0x083A0015, 0x083B0007, 0x083C0005, 0x083C3829, 0x083D9008, 0x08400005,
+    0x08404000, 0x0840502B, 0x0841B801, 0x0841E000, 0x0841F816, 0x08430016,
+    0x0844001E, 0x08470012, 0x0847A001, 0x08480015, 0x08490019, 0x084C0037,
+    0x084DF001, 0x08500000, 0x08508003, 0x0850A802, 0x0850C81C, 0x0853001C,
+    0x0854001C, 0x08560007, 0x0856481B, 0x08580035, 0x085A0015, 0x085B0012,
+    0x085C0011, 0x08600048, 0x08640032, 0x08660032, 0x08680023, 0x08740029,
+    0x08758001, 0x0878001C, 0x08793800, 0x08798015, 0x087B8011, 0x087D8014,
+    0x087F0016, 0x08801834, 0x08838801, 0x0883A800, 0x0884182C, 0x08868018,
+    0x08881823, 0x088A2000, 0x088A3800, 0x088A8022, 0x088BB000, 0x088C182F,
+    0x088E0803, 0x088ED000, 0x088EE000, 0x08900011, 0x08909818, 0x08940006,
+    0x08944000, 0x08945003, 0x0894780E, 0x0894F809, 0x0895802E, 0x08982807,
+    0x08987801, 0x08989815, 0x08995006, 0x08999001, 0x0899A804, 0x0899E800,
+    0x089A8000, 0x089AE804, 0x08A00034, 0x08A23803, 0x08A2F802, 0x08A4002F,
+    0x08A62001, 0x08A63800, 0x08AC002E, 0x08AEC003, 0x08B0002F, 0x08B22000,
+    0x08B4002A, 0x08B5C000, 0x08B8001A, 0x08BA0006, 0x08C0002B, 0x08C5003F,
+    0x08C7F807, 0x08C84800, 0x08C86007, 0x08C8A801, 0x08C8C017, 0x08C9F800,
+    0x08CA0800, 0x08CD0007, 0x08CD5026, 0x08CF0800, 0x08CF1800, 0x08D00000,
+    0x08D05827, 0x08D1D000, 0x08D28000, 0x08D2E02D, 0x08D4E800, 0x08D58048,
+    0x08E00008, 0x08E05024, 0x08E20000, 0x08E3901D, 0x08E80006, 0x08E84001,
+    0x08E85825, 0x08EA3000, 0x08EB0005, 0x08EB3801, 0x08EB501F, 0x08ECC000,
+    0x08F70012, 0x08FD8000, 0x09000399, 0x0920006E, 0x092400C3, 0x097C8060,
+    0x0980042E, 0x0A200246, 0x0B400238, 0x0B52001E, 0x0B53804E, 0x0B56801D,
+    0x0B58002F, 0x0B5A0003, 0x0B5B1814, 0x0B5BE812, 0x0B72003F, 0x0B78004A,
+    0x0B7A8000, 0x0B7C980C, 0x0B7F0001, 0x0B7F1800, 0x0B8007FF, 0x0BC007FF,
+    0x0C0007F7, 0x0C4004D5, 0x0C680008, 0x0D7F8003, 0x0D7FA806, 0x0D7FE801,
+    0x0D800122, 0x0D8A8002, 0x0D8B2003, 0x0D8B818B, 0x0DE0006A, 0x0DE3800C,
+    0x0DE40008, 0x0DE48009, 0x0EA00054, 0x0EA2B046, 0x0EA4F001, 0x0EA51000,
+    0x0EA52801, 0x0EA54803, 0x0EA5700B, 0x0EA5D800, 0x0EA5E806, 0x0EA62840,
+    0x0EA83803, 0x0EA86807, 0x0EA8B006, 0x0EA8F01B, 0x0EA9D803, 0x0EAA0004,
+    0x0EAA3000, 0x0EAA5006, 0x0EAA9153, 0x0EB54018, 0x0EB61018, 0x0EB6E01E,
+    0x0EB7E018, 0x0EB8B01E, 0x0EB9B018, 0x0EBA801E, 0x0EBB8018, 0x0EBC501E,
+    0x0EBD5018, 0x0EBE2007, 0x0EF8001E, 0x0F08002C, 0x0F09B806, 0x0F0A7000,
+    0x0F14801D, 0x0F16002B, 0x0F3F0006, 0x0F3F4003, 0x0F3F6801, 0x0F3F800E,
+    0x0F4000C4, 0x0F480043, 0x0F4A5800, 0x0F700003, 0x0F70281A, 0x0F710801,
+    0x0F712000, 0x0F713800, 0x0F714809, 0x0F71A003, 0x0F71C800, 0x0F71D800,
+    0x0F721000, 0x0F723800, 0x0F724800, 0x0F725800, 0x0F726802, 0x0F728801,
+    0x0F72A000, 0x0F72B800, 0x0F72C800, 0x0F72D800, 0x0F72E800, 0x0F72F800,
+    0x0F730801, 0x0F732000, 0x0F733803, 0x0F736006, 0x0F73A003, 0x0F73C803,
+    0x0F73F000, 0x0F740009, 0x0F745810, 0x0F750802, 0x0F752804, 0x0F755810,
+    0x100007FF, 0x104007FF, 0x108007FF, 0x10C007FF, 0x110007FF, 0x114007FF,
+    0x118007FF, 0x11C007FF, 0x120007FF, 0x124007FF, 0x128007FF, 0x12C007FF,
+    0x130007FF, 0x134007FF, 0x138007FF, 0x13C007FF, 0x140007FF, 0x144007FF,
+    0x148007FF, 0x14C007FF, 0x150006DF, 0x153807FF, 0x157807FF, 0x15B80038,
+    0x15BA00DD, 0x15C107FF, 0x160107FF, 0x16410681, 0x167587FF, 0x16B587FF,
+    0x16F587FF, 0x17358530, 0x17C0021D, 0x180007FF, 0x184007FF, 0x1880034A,
+};
+
+constexpr uint32_t XID_CONTINUE[] = {
+    0x00055000, 0x0005A800, 0x0005B800, 0x0005D000, 0x00060016, 0x0006C01E,
+    0x0007C1C9, 0x0016300B, 0x00170004, 0x00176000, 0x00177000, 0x00180074,
+    0x001BB001, 0x001BD802, 0x001BF800, 0x001C3004, 0x001C6000, 0x001C7013,
+    0x001D1852, 0x001FB88A, 0x00241804, 0x002450A5, 0x00298825, 0x002AC800,
+    0x002B0028, 0x002C882C, 0x002DF800, 0x002E0801, 0x002E2001, 0x002E3800,
+    0x002E801A, 0x002F7803, 0x0030800A, 0x00310049, 0x00337065, 0x0036A807,
+    0x0036F809, 0x00375012, 0x0037F800, 0x0038803A, 0x003A6864, 0x003E0035,
+    0x003FD000, 0x003FE800, 0x0040002D, 0x0042001B, 0x0043000A, 0x00438017,
+    0x00444805, 0x0044C049, 0x00471880, 0x004B3009, 0x004B8812, 0x004C2807,
+    0x004C7801, 0x004C9815, 0x004D5006, 0x004D9000, 0x004DB003, 0x004DE008,
+    0x004E3801, 0x004E5803, 0x004EB800, 0x004EE001, 0x004EF804, 0x004F300B,
+    0x004FE000, 0x004FF000, 0x00500802, 0x00502805, 0x00507801, 0x00509815,
+    0x00515006, 0x00519001, 0x0051A801, 0x0051C001, 0x0051E000, 0x0051F004,
+    0x00523801, 0x00525802, 0x00528800, 0x0052C803, 0x0052F000, 0x0053300F,
+    0x00540802, 0x00542808, 0x00547802, 0x00549815, 0x00555006, 0x00559001,
+    0x0055A804, 0x0055E009, 0x00563802, 0x00565802, 0x00568000, 0x00570003,
+    0x00573009, 0x0057C806, 0x00580802, 0x00582807, 0x00587801, 0x00589815,
+    0x00595006, 0x00599001, 0x0059A804, 0x0059E008, 0x005A3801, 0x005A5802,
+    0x005AA802, 0x005AE001, 0x005AF804, 0x005B3009, 0x005B8800, 0x005C1001,
+    0x005C2805, 0x005C7002, 0x005C9003, 0x005CC801, 0x005CE000, 0x005CF001,
+    0x005D1801, 0x005D4002, 0x005D700B, 0x005DF004, 0x005E3002, 0x005E5003,
+    0x005E8000, 0x005EB800, 0x005F3009, 0x0060000C, 0x00607002, 0x00609016,
+    0x0061500F, 0x0061E008, 0x00623002, 0x00625003, 0x0062A801, 0x0062C002,
+    0x0062E800, 0x00630003, 0x00633009, 0x00640003, 0x00642807, 0x00647002,
+    0x00649016, 0x00655009, 0x0065A804, 0x0065E008, 0x00663002, 0x00665003,
+    0x0066A801, 0x0066E801, 0x00670003, 0x00673009, 0x00678801, 0x0068000C,
+    0x00687002, 0x00689032, 0x006A3002, 0x006A5004, 0x006AA003, 0x006AF804,
+    0x006B3009, 0x006BD005, 0x006C0802, 0x006C2811, 0x006CD017, 0x006D9808,
+    0x006DE800, 0x006E0006, 0x006E5000, 0x006E7805, 0x006EB000, 0x006EC007,
+    0x006F3009, 0x006F9001, 0x00700839, 0x0072000E, 0x00728009, 0x00740801,
+    0x00742000, 0x00743004, 0x00746017, 0x00752800, 0x00753816, 0x00760004,
+    0x00763000, 0x00764005, 0x00768009, 0x0076E003, 0x00780000, 0x0078C001,
+    0x00790009, 0x0079A800, 0x0079B800, 0x0079C800, 0x0079F009, 0x007A4823,
+    0x007B8813, 0x007C3011, 0x007CC823, 0x007E3000, 0x00800049, 0x0082804D,
+    0x00850025, 0x00863800, 0x00866800, 0x0086802A, 0x0087E14C, 0x00925003,
+    0x00928006, 0x0092C000, 0x0092D003, 0x00930028, 0x00945003, 0x00948020,
+    0x00959003, 0x0095C006, 0x00960000, 0x00961003, 0x0096400E, 0x0096C038,
+    0x00989003, 0x0098C042, 0x009AE802, 0x009B4808, 0x009C000F, 0x009D0055,
+    0x009FC005, 0x00A00A6B, 0x00B37810, 0x00B40819, 0x00B5004A, 0x00B7700A,
+    0x00B80015, 0x00B8F815, 0x00BA0013, 0x00BB000C, 0x00BB7002, 0x00BB9001,
+    0x00BC0053, 0x00BEB800, 0x00BEE001, 0x00BF0009, 0x00C05802, 0x00C0780A,
+    0x00C10058, 0x00C4002A, 0x00C58045, 0x00C8001E, 0x00C9000B, 0x00C9800B,
+    0x00CA3027, 0x00CB8004, 0x00CC002B, 0x00CD8019, 0x00CE800A, 0x00D0001B,
+    0x00D1003E, 0x00D3001C, 0x00D3F80A, 0x00D48009, 0x00D53800, 0x00D5800D,
+    0x00D5F80F, 0x00D8004C, 0x00DA8009, 0x00DB5808, 0x00DC0073, 0x00E00037,
+    0x00E20009, 0x00E26830, 0x00E40008, 0x00E4802A, 0x00E5E802, 0x00E68002,
+    0x00E6A026, 0x00E80215, 0x00F8C005, 0x00F90025, 0x00FA4005, 0x00FA8007,
+    0x00FAC800, 0x00FAD800, 0x00FAE800, 0x00FAF81E, 0x00FC0034, 0x00FDB006,
+    0x00FDF000, 0x00FE1002, 0x00FE3006, 0x00FE8003, 0x00FEB005, 0x00FF000C,
+    0x00FF9002, 0x00FFB006, 0x0101F801, 0x0102A000, 0x01038800, 0x0103F800,
+    0x0104800C, 0x0106800C, 0x01070800, 0x0107280B, 0x01081000, 0x01083800,
+    0x01085009, 0x0108A800, 0x0108C005, 0x01092000, 0x01093000, 0x01094000,
+    0x0109500F, 0x0109E003, 0x010A2804, 0x010A7000, 0x010B0028, 0x016000E4,
+    0x01675808, 0x01680025, 0x01693800, 0x01696800, 0x01698037, 0x016B7800,
+    0x016BF817, 0x016D0006, 0x016D4006, 0x016D8006, 0x016DC006, 0x016E0006,
+    0x016E4006, 0x016E8006, 0x016EC006, 0x016F001F, 0x01802802, 0x0181080E,
+    0x01818804, 0x0181C004, 0x01820855, 0x0184C801, 0x0184E802, 0x01850859,
+    0x0187E003, 0x0188282A, 0x0189885D, 0x018D001F, 0x018F800F, 0x01A007FF,
+    0x01E007FF, 0x022007FF, 0x026001BF, 0x027007FF, 0x02B007FF, 0x02F007FF,
+    0x033007FF, 0x037007FF, 0x03B007FF, 0x03F007FF, 0x043007FF, 0x047007FF,
+    0x04B007FF, 0x04F0068C, 0x0526802D, 0x0528010C, 0x0530801B, 0x0532002F,
+    0x0533A009, 0x0533F872, 0x0538B808, 0x05391066, 0x053C583F, 0x053E8001,
+    0x053E9800, 0x053EA804, 0x053F9035, 0x05416000, 0x05420033, 0x05440045,
+    0x05468009, 0x05470017, 0x0547D800, 0x0547E830, 0x05498023, 0x054B001C,
+    0x054C0040, 0x054E780A, 0x054F001E, 0x05500036, 0x0552000D, 0x05528009,
+    0x05530016, 0x0553D048, 0x0556D802, 0x0557000F, 0x05579004, 0x05580805,
+    0x05584805, 0x05588805, 0x05590006, 0x05594006, 0x0559802A, 0x055AE00D,
+    0x055B807A, 0x055F6001, 0x055F8009, 0x056007FF, 0x05A007FF, 0x05E007FF,
+    0x062007FF, 0x066007FF, 0x06A003A3, 0x06BD8016, 0x06BE5830, 0x07C8016D,
+    0x07D38069, 0x07D80006, 0x07D89804, 0x07D8E80B, 0x07D9500C, 0x07D9C004,
+    0x07D9F000, 0x07DA0001, 0x07DA1801, 0x07DA306B, 0x07DE988A, 0x07E320D9,
+    0x07EA803F, 0x07EC9035, 0x07EF8009, 0x07F0000F, 0x07F1000F, 0x07F19801,
+    0x07F26802, 0x07F38800, 0x07F39800, 0x07F3B800, 0x07F3C800, 0x07F3D800,
+    0x07F3E800, 0x07F3F87D, 0x07F88009, 0x07F90819, 0x07F9F800, 0x07FA0819,
+    0x07FB3058, 0x07FE1005, 0x07FE5005, 0x07FE9005, 0x07FED002, 0x0800000B,
+    0x08006819, 0x08014012, 0x0801E001, 0x0801F80E, 0x0802800D, 0x0804007A,
+    0x080A0034, 0x080FE800, 0x0814001C, 0x08150030, 0x08170000, 0x0818001F,
+    0x0819681D, 0x081A802A, 0x081C001D, 0x081D0023, 0x081E4007, 0x081E8804,
+    0x0820009D, 0x08250009, 0x08258023, 0x0826C023, 0x08280027, 0x08298033,
+    0x082B800A, 0x082BE00E, 0x082C6006, 0x082CA001, 0x082CB80A, 0x082D180E,
+    0x082D9806, 0x082DD801, 0x08300136, 0x083A0015, 0x083B0007, 0x083C0005,
+    0x083C3829, 0x083D9008, 0x08400005, 0x08404000, 0x0840502B, 0x0841B801,
+    0x0841E000, 0x0841F816, 0x08430016, 0x0844001E, 0x08470012, 0x0847A001,
+    0x08480015, 0x08490019, 0x084C0037, 0x084DF001, 0x08500003, 0x08502801,
+    0x08506007, 0x0850A802, 0x0850C81C, 0x0851C002, 0x0851F800, 0x0853001C,
+    0x0854001C, 0x08560007, 0x0856481D, 0x08580035, 0x085A0015, 0x085B0012,
+    0x085C0011, 0x08600048, 0x08640032, 0x08660032, 0x08680027, 0x08698009,
+    0x08740029, 0x08755801, 0x08758001, 0x0878001C, 0x08793800, 0x08798020,
+    0x087B8015, 0x087D8014, 0x087F0016, 0x08800046, 0x0883300F, 0x0883F83B,
+    0x08861000, 0x08868018, 0x08878009, 0x08880034, 0x0889B009, 0x088A2003,
+    0x088A8023, 0x088BB000, 0x088C0044, 0x088E4803, 0x088E700C, 0x088EE000,
+    0x08900011, 0x08909824, 0x0891F000, 0x08940006, 0x08944000, 0x08945003,
+    0x0894780E, 0x0894F809, 0x0895803A, 0x08978009, 0x08980003, 0x08982807,
+    0x08987801, 0x08989815, 0x08995006, 0x08999001, 0x0899A804, 0x0899D809,
+    0x089A3801, 0x089A5802, 0x089A8000, 0x089AB800, 0x089AE806, 0x089B3006,
+    0x089B8004, 0x08A0004A, 0x08A28009, 0x08A2F003, 0x08A40045, 0x08A63800,
+    0x08A68009, 0x08AC0035, 0x08ADC008, 0x08AEC005, 0x08B00040, 0x08B22000,
+    0x08B28009, 0x08B40038, 0x08B60009, 0x08B8001A, 0x08B8E80E, 0x08B98009,
+    0x08BA0006, 0x08C0003A, 0x08C50049, 0x08C7F807, 0x08C84800, 0x08C86007,
+    0x08C8A801, 0x08C8C01D, 0x08C9B801, 0x08C9D808, 0x08CA8009, 0x08CD0007,
+    0x08CD502D, 0x08CED007, 0x08CF1801, 0x08D0003E, 0x08D23800, 0x08D28049,
+    0x08D4E800, 0x08D58048, 0x08E00008, 0x08E0502C, 0x08E1C008, 0x08E28009,
+    0x08E3901D, 0x08E49015, 0x08E5480D, 0x08E80006, 0x08E84001, 0x08E8582B,
+    0x08E9D000, 0x08E9E001, 0x08E9F808, 0x08EA8009, 0x08EB0005, 0x08EB3801,
+    0x08EB5024, 0x08EC8001, 0x08EC9805, 0x08ED0009, 0x08F70016, 0x08FD8000,
+    0x09000399, 0x0920006E, 0x092400C3, 0x097C8060, 0x0980042E, 0x0A200246,
+    0x0B400238, 0x0B52001E, 0x0B530009, 0x0B53804E, 0x0B560009, 0x0B56801D,
+    0x0B578004, 0x0B580036, 0x0B5A0003, 0x0B5A8009, 0x0B5B1814, 0x0B5BE812,
+    0x0B72003F, 0x0B78004A, 0x0B7A7838, 0x0B7C7810, 0x0B7F0001, 0x0B7F1801,
+    0x0B7F8001, 0x0B8007FF, 0x0BC007FF, 0x0C0007F7, 0x0C4004D5, 0x0C680008,
+    0x0D7F8003, 0x0D7FA806, 0x0D7FE801, 0x0D800122, 0x0D8A8002, 0x0D8B2003,
+    0x0D8B818B, 0x0DE0006A, 0x0DE3800C, 0x0DE40008, 0x0DE48009, 0x0DE4E801,
+    0x0E78002D, 0x0E798016, 0x0E8B2804, 0x0E8B6805, 0x0E8BD807, 0x0E8C2806,
+    0x0E8D5003, 0x0E921002, 0x0EA00054, 0x0EA2B046, 0x0EA4F001, 0x0EA51000,
+    0x0EA52801, 0x0EA54803, 0x0EA5700B, 0x0EA5D800, 0x0EA5E806, 0x0EA62840,
+    0x0EA83803, 0x0EA86807, 0x0EA8B006, 0x0EA8F01B, 0x0EA9D803, 0x0EAA0004,
+    0x0EAA3000, 0x0EAA5006, 0x0EAA9153, 0x0EB54018, 0x0EB61018, 0x0EB6E01E,
+    0x0EB7E018, 0x0EB8B01E, 0x0EB9B018, 0x0EBA801E, 0x0EBB8018, 0x0EBC501E,
+    0x0EBD5018, 0x0EBE2007, 0x0EBE7031, 0x0ED00036, 0x0ED1D831, 0x0ED3A800,
+    0x0ED42000, 0x0ED4D804, 0x0ED5080E, 0x0EF8001E, 0x0F000006, 0x0F004010,
+    0x0F00D806, 0x0F011801, 0x0F013004, 0x0F08002C, 0x0F09800D, 0x0F0A0009,
+    0x0F0A7000, 0x0F14801E, 0x0F160039, 0x0F3F0006, 0x0F3F4003, 0x0F3F6801,
+    0x0F3F800E, 0x0F4000C4, 0x0F468006, 0x0F48004B, 0x0F4A8009, 0x0F700003,
+    0x0F70281A, 0x0F710801, 0x0F712000, 0x0F713800, 0x0F714809, 0x0F71A003,
+    0x0F71C800, 0x0F71D800, 0x0F721000, 0x0F723800, 0x0F724800, 0x0F725800,
+    0x0F726802, 0x0F728801, 0x0F72A000, 0x0F72B800, 0x0F72C800, 0x0F72D800,
+    0x0F72E800, 0x0F72F800, 0x0F730801, 0x0F732000, 0x0F733803, 0x0F736006,
+    0x0F73A003, 0x0F73C803, 0x0F73F000, 0x0F740009, 0x0F745810, 0x0F750802,
+    0x0F752804, 0x0F755810, 0x0FDF8009, 0x100007FF, 0x104007FF, 0x108007FF,
+    0x10C007FF, 0x110007FF, 0x114007FF, 0x118007FF, 0x11C007FF, 0x120007FF,
+    0x124007FF, 0x128007FF, 0x12C007FF, 0x130007FF, 0x134007FF, 0x138007FF,
+    0x13C007FF, 0x140007FF, 0x144007FF, 0x148007FF, 0x14C007FF, 0x150006DF,
+    0x153807FF, 0x157807FF, 0x15B80038, 0x15BA00DD, 0x15C107FF, 0x160107FF,
+    0x16410681, 0x167587FF, 0x16B587FF, 0x16F587FF, 0x17358530, 0x17C0021D,
+    0x180007FF, 0x184007FF, 0x1880034A, 0x700800EF,
+};
+
+constexpr unsigned RANGE_BITS = 11;
+
+template <size_t N>
+bool in_table(const uint32_t (&table)[N], char32_t code_point) {
+    // The last range starting at or before `code_point` is the only one that can hold it
+    uint32_t key = (static_cast<uint32_t>(code_point) << RANGE_BITS) | ((1u << RANGE_BITS) - 1);
+    const uint32_t* entry = std::upper_bound(std::begin(table), std::end(table), key);
+    if (entry == std::begin(table)) {
+        return false;
+    }
+    --entry;
+    uint32_t first = *entry >> RANGE_BITS;
+    uint32_t count = (*entry & ((1u << RANGE_BITS) - 1)) + 1;
+    return code_point - first < count;
+}
+
+bool is_ascii_letter(char32_t code_point) {
+    return (code_point | 0x20) >= 'a' && (code_point | 0x20) <= 'z';
+}
+
+} // namespace
+
+bool is_xid_start(char32_t code_point) {
+    if (code_point < 0x80) {
+        return is_ascii_letter(code_point) || code_point == '_';
+    }
+    return in_table(XID_START, code_point);
+}
+
+bool is_xid_continue(char32_t code_point) {
+    if (code_point < 0x80) {
+        return is_ascii_letter(code_point) || (code_point >= '0' && code_point <= '9') || code_point == '_';
+    }
+    return in_table(XID_CONTINUE, code_point);
+}
+
+} // namespace dacite::unicode
\ No newline at end of file
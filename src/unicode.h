@@ -0,0 +1,11 @@
+#pragma once
+
+namespace dacite::unicode {
+
+/// Check if `code_point` may start an identifier (XID_Start, or '_')
+bool is_xid_start(char32_t code_point);
+
+/// Check if `code_point` may continue an identifier (XID_Continue)
+bool is_xid_continue(char32_t code_point);
+
+} // namespace dacite::unicode
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "value.h"
+#include <charconv>
 #include <stdexcept>
 
 namespace dacite {
@@ -10,6 +11,10 @@ ValueType Value::get_type() const {
         return ValueType::INTEGER;
     } else if (std::holds_alternative<bool>(data_)) {
         return ValueType::BOOLEAN;
+    } else if (std::holds_alternative<double>(data_)) {
+        return ValueType::FLOAT;
+    } else if (std::holds_alternative<StringRef>(data_)) {
+        return ValueType::STRING;
     }
     // Should never happen with current implementation
     throw std::runtime_error("Unknown value type");
@@ -29,6 +34,27 @@ bool Value::as_boolean() const {
     return std::get<bool>(data_);
 }
 
+double Value::as_float() const {
+    if (!is_float()) {
+        throw std::runtime_error("Value is not a float");
+    }
+    return std::get<double>(data_);
+}
+
+std::string_view Value::as_string() const {
+    if (!is_string()) {
+        throw std::runtime_error("Value is not a string");
+    }
+    return std::get<StringRef>(data_).view();
+}
+
+StringRef& Value::as_string_ref() {
+    if (!is_string()) {
+        throw std::runtime_error("Value is not a string");
+    }
+    return std::get<StringRef>(data_);
+}
+
 std::string Value::to_string() const {
     switch (get_type()) {
         case ValueType::NIL:
@@ -39,6 +65,14 @@ std::string Value::to_string() const {
             return as_boolean() ? "true" : "false";
         case ValueType::FUNCTION:
             return "<function>";
+        case ValueType::FLOAT: {
+            // Shortest text that reads back as the same double
+            char buffer[32];
+            auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), as_float());
+            return std::string(buffer, end);
+        }
+        case ValueType::STRING:
+            return std::string(as_string());
     }
     return "<unknown>";
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <variant>
+#include "string_object.h"
 
 namespace dacite {
 
@@ -10,7 +13,9 @@ enum class ValueType {
     NIL,
     INTEGER,
     BOOLEAN,
-    FUNCTION
+    FUNCTION,
+    FLOAT,
+    STRING
 };
 
 /// A discriminated union representing values in the VM
@@ -25,6 +30,12 @@ public:
     /// Constructor for boolean values
     explicit Value(bool value) : data_(value) {}
     
+    /// Constructor for floating-point values
+    explicit Value(double value) : data_(value) {}
+    
+    /// Constructor for string values
+    explicit Value(StringRef value) : data_(std::move(value)) {}
+    
     /// Get the type of this value
     ValueType get_type() const;
     
@@ -32,6 +43,8 @@ public:
     bool is_nil() const { return std::holds_alternative<std::monostate>(data_); }
     bool is_integer() const { return std::holds_alternative<int32_t>(data_); }
     bool is_boolean() const { return std::holds_alternative<bool>(data_); }
+    bool is_float() const { return std::holds_alternative<double>(data_); }
+    bool is_string() const { return std::holds_alternative<StringRef>(data_); }
     
     /// Get the integer value (throws if not integer)
     int32_t as_integer() const;
@@ -39,7 +52,16 @@ public:
     /// Get the boolean value (throws if not boolean)
     bool as_boolean() const;
     
-    /// Convert to string for debugging
+    /// Get the floating-point value (throws if not float)
+    double as_float() const;
+    
+    /// Get the string's text (throws if not string); valid while the value's string is referenced
+    std::string_view as_string() const;
+    
+    /// Get the string reference itself, e.g. to append in place (throws if not string)
+    StringRef& as_string_ref();
+    
+    /// Convert to string for debugging (strings convert to their text)
     std::string to_string() const;
     
     /// Equality comparison
@@ -47,7 +69,28 @@ public:
     bool operator!=(const Value& other) const { return !(*this == other); }
 
 private:
-    std::variant<std::monostate, int32_t, bool> data_;
+    std::variant<std::monostate, int32_t, bool, double, StringRef> data_;
 };
 
+/// Integer arithmetic wraps on overflow (two's complement)
+constexpr int32_t wrapping_add(int32_t a, int32_t b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+}
+
+constexpr int32_t wrapping_subtract(int32_t a, int32_t b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b));
+}
+
+constexpr int32_t wrapping_multiply(int32_t a, int32_t b) {
+    return static_cast<int32_t>(static_cast<uint32_t>(a) * static_cast<uint32_t>(b));
+}
+
+/// Divisor must be non-zero; INT32_MIN / -1 wraps to INT32_MIN
+constexpr int32_t wrapping_divide(int32_t a, int32_t b) {
+    if (b == -1) {
+        return wrapping_subtract(0, a);
+    }
+    return a / b;
+}
+
 } // namespace dacite
\ No newline at end of file
@@ -1,16 +1,50 @@
 #include "vm.h"
+#include "string_kernels.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <charconv>
+#include <unistd.h>
 
 namespace dacite {
 
-VM::VM(const VMConfig& config) : config_(config) {
+VM::VM(const VMConfig& config)
+    : config_(config)
+    , stack_(config.memory_resource ? config.memory_resource : std::pmr::get_default_resource()) {
     reset();
 }
 
 VMResult VM::run(const Chunk& chunk) {
+    StageTimer timer(config_.metrics, Stage::RUN);
+    instructions_executed_ = 0;
+    
+    // Under a perf map, enter the loop through the function's native thunk so
+    // samples inside it unwind to a named address
+    const void* thunk = nullptr;
+    if (config_.perf_map) {
+        const std::string& name = chunk.get_name();
+        thunk = config_.perf_map->thunk("dacite::" + (name.empty() ? std::string("<chunk>") : name),
+                                        reinterpret_cast<const void*>(&VM::execute_entry));
+    }
+    using Entry = VMResult (*)(VM*, const Chunk*);
+    VMResult result = thunk ? reinterpret_cast<Entry>(thunk)(this, &chunk) : execute(chunk);
+    copy_borrowed_strings();
+    if (stdout_buffer_) {
+        stdout_buffer_->flush();
+    }
+    
+    if (config_.metrics) {
+        config_.metrics->record_run(instructions_executed_, result == VMResult::RUNTIME_ERROR);
+    }
+    return result;
+}
+
+VMResult VM::execute_entry(VM* vm, const Chunk* chunk) {
+    return vm->execute(*chunk);
+}
+
+VMResult VM::execute(const Chunk& chunk) {
     if (chunk.empty()) {
         return VMResult::OK;
     }
@@ -20,18 +54,42 @@ VMResult VM::run(const Chunk& chunk) {
     
     debug_print("=== VM Execution ===");
     
+    if (config_.profile) {
+        config_.profile->runs++;
+    }
+    
+    const std::string& function_name = chunk.get_name();
+    size_t current_line = 0;
+    
+    // Error and debug paths are marked [[unlikely]] so the host compiler
+    // lays them out after the hot dispatch code.
     while (ip < code.size()) {
-        if (config_.debug_mode) {
+        if (config_.debug_mode) [[unlikely]] {
             debug_print_stack();
             debug_print_instruction(chunk, ip);
         }
         
+        if (config_.perf_line_markers) {
+            size_t line = chunk.get_line(ip);
+            if (line != current_line) {
+                current_line = line;
+                dacite_perf_line(function_name.c_str(), line);
+            }
+        }
+        
         OpCode instruction = static_cast<OpCode>(code[ip]);
         ip++;
+        if (config_.metrics) {
+            instructions_executed_++;
+        }
+        
+        if (config_.profile) {
+            record_profile(instruction, chunk, ip);
+        }
         
         switch (instruction) {
             case OpCode::OP_CONSTANT: {
-                if (ip >= code.size()) {
+                if (ip >= code.size()) [[unlikely]] {
                     runtime_error("Missing constant index after OP_CONSTANT");
                     return VMResult::RUNTIME_ERROR;
                 }
@@ -49,166 +107,392 @@ VMResult VM::run(const Chunk& chunk) {
             }
             
             case OpCode::OP_RETURN: {
-                if (stack_.empty()) {
+                if (stack_.empty()) [[unlikely]] {
                     runtime_error("Cannot return: stack is empty");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value result = pop();
-                debug_print("Function returned: " + result.to_string());
                 // For now, we just leave the result on the stack
-                push(result);
+                if (config_.debug_mode) {
+                    debug_print("Function returned: " + stack_.back().to_string());
+                }
                 return VMResult::OK;
             }
             
             // Arithmetic operations
             case OpCode::OP_ADD: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for addition");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
-                    runtime_error("Addition requires integer values");
-                    return VMResult::RUNTIME_ERROR;
+                const Value& b = stack_.back();
+                Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
+                    if (!a.is_string() || !b.is_string()) {
+                        runtime_error("Addition requires two integers or two strings");
+                        return VMResult::RUNTIME_ERROR;
+                    }
+                    // A concatenation's result is referenced only from the stack, so a chain
+                    // of them grows one string in place instead of copying it every time
+                    a.as_string_ref().append(b.as_string());
+                    stack_.pop_back();
+                    break;
                 }
-                push(Value(a.as_integer() + b.as_integer()));
+                replace_top(Value(wrapping_add(a.as_integer(), b.as_integer())), 2);
                 break;
             }
             
             case OpCode::OP_SUBTRACT: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for subtraction");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
                     runtime_error("Subtraction requires integer values");
                     return VMResult::RUNTIME_ERROR;
                 }
-                push(Value(a.as_integer() - b.as_integer()));
+                replace_top(Value(wrapping_subtract(a.as_integer(), b.as_integer())), 2);
                 break;
             }
             
             case OpCode::OP_MULTIPLY: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for multiplication");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
                     runtime_error("Multiplication requires integer values");
                     return VMResult::RUNTIME_ERROR;
                 }
-                push(Value(a.as_integer() * b.as_integer()));
+                replace_top(Value(wrapping_multiply(a.as_integer(), b.as_integer())), 2);
                 break;
             }
             
             case OpCode::OP_DIVIDE: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for division");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
                     runtime_error("Division requires integer values");
                     return VMResult::RUNTIME_ERROR;
                 }
-                if (b.as_integer() == 0) {
+                if (b.as_integer() == 0) [[unlikely]] {
                     runtime_error("Division by zero");
                     return VMResult::RUNTIME_ERROR;
                 }
-                push(Value(a.as_integer() / b.as_integer()));
+                replace_top(Value(wrapping_divide(a.as_integer(), b.as_integer())), 2);
                 break;
             }
             
             // Comparison operations
             case OpCode::OP_EQUAL: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for equality comparison");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                push(Value(a == b));
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                replace_top(Value(a == b), 2);
                 break;
             }
             
             case OpCode::OP_NOT_EQUAL: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for inequality comparison");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                push(Value(a != b));
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                replace_top(Value(a != b), 2);
                 break;
             }
             
             case OpCode::OP_LESS: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for less than comparison");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
                     runtime_error("Less than comparison requires integer values");
                     return VMResult::RUNTIME_ERROR;
                 }
-                push(Value(a.as_integer() < b.as_integer()));
+                replace_top(Value(a.as_integer() < b.as_integer()), 2);
                 break;
             }
             
             case OpCode::OP_LESS_EQUAL: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for less or equal comparison");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
                     runtime_error("Less or equal comparison requires integer values");
                     return VMResult::RUNTIME_ERROR;
                 }
-                push(Value(a.as_integer() <= b.as_integer()));
+                replace_top(Value(a.as_integer() <= b.as_integer()), 2);
                 break;
             }
             
             case OpCode::OP_GREATER: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for greater than comparison");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
                     runtime_error("Greater than comparison requires integer values");
                     return VMResult::RUNTIME_ERROR;
                 }
-                push(Value(a.as_integer() > b.as_integer()));
+                replace_top(Value(a.as_integer() > b.as_integer()), 2);
                 break;
             }
             
             case OpCode::OP_GREATER_EQUAL: {
-                if (stack_.size() < 2) {
+                if (stack_.size() < 2) [[unlikely]] {
                     runtime_error("Not enough values on stack for greater or equal comparison");
                     return VMResult::RUNTIME_ERROR;
                 }
-                Value b = pop();
-                Value a = pop();
-                if (!a.is_integer() || !b.is_integer()) {
+                const Value& b = stack_.back();
+                const Value& a = stack_[stack_.size() - 2];
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
                     runtime_error("Greater or equal comparison requires integer values");
                     return VMResult::RUNTIME_ERROR;
                 }
-                push(Value(a.as_integer() >= b.as_integer()));
+                replace_top(Value(a.as_integer() >= b.as_integer()), 2);
+                break;
+            }
+            
+            // Superinstructions
+            case OpCode::OP_ADD_CONSTANT: {
+                if (ip >= code.size()) [[unlikely]] {
+                    runtime_error("Missing constant index after OP_ADD_CONSTANT");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                uint8_t constant_index = code[ip];
+                ip++;
+                
+                if (stack_.empty()) [[unlikely]] {
+                    runtime_error("Not enough values on stack for addition");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                if (constant_index >= chunk.get_constants().size()) [[unlikely]] {
+                    runtime_error("Invalid constant index: Constant index out of range");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                const Value& b = chunk.get_constant(constant_index);
+                const Value& a = stack_.back();
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
+                    runtime_error("Addition requires integer values");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                replace_top(Value(wrapping_add(a.as_integer(), b.as_integer())), 1);
+                break;
+            }
+            
+            case OpCode::OP_SUBTRACT_CONSTANT: {
+                if (ip >= code.size()) [[unlikely]] {
+                    runtime_error("Missing constant index after OP_SUBTRACT_CONSTANT");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                uint8_t constant_index = code[ip];
+                ip++;
+                
+                if (stack_.empty()) [[unlikely]] {
+                    runtime_error("Not enough values on stack for subtraction");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                if (constant_index >= chunk.get_constants().size()) [[unlikely]] {
+                    runtime_error("Invalid constant index: Constant index out of range");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                const Value& b = chunk.get_constant(constant_index);
+                const Value& a = stack_.back();
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
+                    runtime_error("Subtraction requires integer values");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                replace_top(Value(wrapping_subtract(a.as_integer(), b.as_integer())), 1);
+                break;
+            }
+            
+            case OpCode::OP_MULTIPLY_CONSTANT: {
+                if (ip >= code.size()) [[unlikely]] {
+                    runtime_error("Missing constant index after OP_MULTIPLY_CONSTANT");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                uint8_t constant_index = code[ip];
+                ip++;
+                
+                if (stack_.empty()) [[unlikely]] {
+                    runtime_error("Not enough values on stack for multiplication");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                if (constant_index >= chunk.get_constants().size()) [[unlikely]] {
+                    runtime_error("Invalid constant index: Constant index out of range");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                const Value& b = chunk.get_constant(constant_index);
+                const Value& a = stack_.back();
+                if (!a.is_integer() || !b.is_integer()) [[unlikely]] {
+                    runtime_error("Multiplication requires integer values");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                replace_top(Value(wrapping_multiply(a.as_integer(), b.as_integer())), 1);
+                break;
+            }
+            
+            // Host columns are read in place; only pushed results are boxed
+            case OpCode::OP_COLUMN_LENGTH: {
+                const Column* column = column_operand(chunk, ip, "OP_COLUMN_LENGTH");
+                if (!column) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                if (column->size() > static_cast<size_t>(INT32_MAX)) [[unlikely]] {
+                    runtime_error("Column length does not fit in an integer");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                push(Value(static_cast<int32_t>(column->size())));
+                break;
+            }
+            
+            case OpCode::OP_COLUMN_GET: {
+                const Column* column = column_operand(chunk, ip, "OP_COLUMN_GET");
+                if (!column) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                if (stack_.empty()) [[unlikely]] {
+                    runtime_error("Not enough values on stack for column access");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                const Value& index = stack_.back();
+                if (!index.is_integer()) [[unlikely]] {
+                    runtime_error("Column index must be an integer");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                if (index.as_integer() < 0 || static_cast<size_t>(index.as_integer()) >= column->size()) [[unlikely]] {
+                    runtime_error("Column index out of range");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                replace_top(column->get(static_cast<size_t>(index.as_integer())), 1);
+                break;
+            }
+            
+            case OpCode::OP_COLUMN_SUM: {
+                const Column* column = column_operand(chunk, ip, "OP_COLUMN_SUM");
+                if (!column) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                push(column->sum());
+                break;
+            }
+            
+            case OpCode::OP_POP: {
+                if (stack_.empty()) [[unlikely]] {
+                    runtime_error("Cannot pop: stack is empty");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                stack_.pop_back();
+                break;
+            }
+            
+            case OpCode::OP_PRINT: {
+                if (stack_.empty()) [[unlikely]] {
+                    runtime_error("Not enough values on stack for print");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                const Value& value = stack_.back();
+                if (value.is_string()) {
+                    output().write_line(value.as_string());
+                } else if (value.is_integer()) {
+                    char digits[16];
+                    auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value.as_integer());
+                    output().write_line(std::string_view(digits, end - digits));
+                } else {
+                    output().write_line(value.to_string());
+                }
+                replace_top(Value(), 1);
+                break;
+            }
+            
+            case OpCode::OP_READ_LINE: {
+                // Mapped input is referenced in place; buffered lines are reused by the next read
+                LineReader& reader = input();
+                auto line = reader.next_line();
+                if (!line) {
+                    push(Value());
+                } else if (reader.is_mapped()) {
+                    push(Value(StringRef(StringObject::make_view(*line))));
+                } else {
+                    push(Value(StringRef::make(std::string(*line))));
+                }
+                break;
+            }
+            
+            // String builtins; results that are pieces of a string are slices of it
+            case OpCode::OP_FIND: {
+                if (!string_operands("find", 2)) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                size_t offset = text::find(peek(1).as_string(), peek(0).as_string());
+                replace_top(Value(offset == std::string_view::npos ? -1 : static_cast<int32_t>(offset)), 2);
+                break;
+            }
+            
+            case OpCode::OP_SPLIT: {
+                if (!string_operands("split", 2, 1)) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                if (!peek(0).is_integer() || peek(0).as_integer() < 0) [[unlikely]] {
+                    runtime_error("split requires a non-negative integer index");
+                    return VMResult::RUNTIME_ERROR;
+                }
+                StringRef& source = stack_[stack_.size() - 3].as_string_ref();
+                auto field = text::split_field(source.view(), peek(1).as_string(),
+                                               static_cast<size_t>(peek(0).as_integer()));
+                Value result;
+                if (field) {
+                    result = Value(StringRef(StringObject::make_slice(source.get(), *field)));
+                }
+                replace_top(std::move(result), 3);
+                break;
+            }
+            
+            case OpCode::OP_EQUALS_IGNORE_CASE: {
+                if (!string_operands("equals_ignore_case", 2)) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                replace_top(Value(text::equals_ignore_case(peek(1).as_string(), peek(0).as_string())), 2);
+                break;
+            }
+            
+            case OpCode::OP_IS_UTF8: {
+                if (!string_operands("is_utf8", 1)) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                replace_top(Value(text::is_valid_utf8(peek(0).as_string())), 1);
+                break;
+            }
+            
+            case OpCode::OP_COUNT_LINES: {
+                if (!string_operands("count_lines", 1)) [[unlikely]] {
+                    return VMResult::RUNTIME_ERROR;
+                }
+                replace_top(Value(static_cast<int32_t>(text::count_lines(peek(0).as_string()))), 1);
                 break;
             }
             
-            default: {
+            [[unlikely]] default: {
                 runtime_error("Unknown opcode: " + std::to_string(static_cast<int>(instruction)));
                 return VMResult::RUNTIME_ERROR;
             }
@@ -218,7 +502,7 @@ VMResult VM::run(const Chunk& chunk) {
     return VMResult::OK;
 }
 
-Value VM::peek_stack_top() const {
+const Value& VM::peek_stack_top() const {
     if (stack_.empty()) {
         throw std::runtime_error("Stack is empty");
     }
@@ -230,32 +514,168 @@ void VM::reset() {
     error_message_.clear();
 }
 
+void VM::copy_borrowed_strings() {
+    for (Value& value : stack_) {
+        if (!value.is_string()) continue;
+        const StringObject* object = value.as_string_ref().get();
+        if (object && object->borrows_static()) {
+            value = Value(StringRef::make(std::string(object->view())));
+        }
+    }
+}
+
+OutputBuffer& VM::output() {
+    if (config_.output) {
+        return *config_.output;
+    }
+    if (!stdout_buffer_) {
+        stdout_buffer_ = std::make_unique<OutputBuffer>(STDOUT_FILENO);
+    }
+    return *stdout_buffer_;
+}
+
+LineReader& VM::input() {
+    if (config_.input) {
+        return *config_.input;
+    }
+    if (!stdin_reader_) {
+        stdin_reader_ = std::make_unique<LineReader>(STDIN_FILENO);
+    }
+    return *stdin_reader_;
+}
+
+bool VM::string_operands(std::string_view builtin, size_t count, size_t above) {
+    if (stack_.size() < count + above) {
+        runtime_error("Not enough values on stack for " + std::string(builtin));
+        return false;
+    }
+    for (size_t distance = above; distance < count + above; ++distance) {
+        if (!peek(distance).is_string()) {
+            runtime_error(std::string(builtin) + " requires string arguments");
+            return false;
+        }
+    }
+    return true;
+}
+
+ColumnBinding VM::bind_column(std::span<const int32_t> values) {
+    return bind_column(Column(values));
+}
+
+ColumnBinding VM::bind_column(std::span<const double> values) {
+    return bind_column(Column(values));
+}
+
+ColumnBinding VM::bind_column(Column column) {
+    size_t slot = 0;
+    while (slot < columns_.size() && columns_[slot].is_bound()) {
+        ++slot;
+    }
+    if (slot > UINT8_MAX) {
+        return {};
+    }
+    if (slot == columns_.size()) {
+        columns_.emplace_back();
+    }
+    columns_[slot] = column;
+    return ColumnBinding(this, static_cast<uint8_t>(slot));
+}
+
+void VM::unbind_column(uint8_t slot) {
+    columns_[slot] = Column();
+}
+
+const Column* VM::column_operand(const Chunk& chunk, size_t& ip, std::string_view instruction) {
+    const auto& code = chunk.get_code();
+    if (ip >= code.size()) {
+        runtime_error("Missing column slot after " + std::string(instruction));
+        return nullptr;
+    }
+    uint8_t slot = code[ip];
+    ip++;
+    if (slot >= columns_.size() || !columns_[slot].is_bound()) {
+        runtime_error("Column " + std::to_string(slot) + " is not bound");
+        return nullptr;
+    }
+    return &columns_[slot];
+}
+
 void VM::push(const Value& value) {
+    push(Value(value));
+}
+
+void VM::push(Value&& value) {
     if (stack_.size() >= config_.max_stack_size) {
         runtime_error("Stack overflow");
         return;
     }
-    stack_.push_back(value);
-    debug_print("Pushed: " + value.to_string());
+    if (config_.debug_mode) {
+        debug_print("Pushed: " + value.to_string());
+    }
+    stack_.push_back(std::move(value));
 }
 
 Value VM::pop() {
     if (stack_.empty()) {
         throw std::runtime_error("Stack underflow");
     }
-    Value value = stack_.back();
+    Value value = std::move(stack_.back());
     stack_.pop_back();
-    debug_print("Popped: " + value.to_string());
+    if (config_.debug_mode) {
+        debug_print("Popped: " + value.to_string());
+    }
     return value;
 }
 
-Value VM::peek(size_t distance) const {
+const Value& VM::peek(size_t distance) const {
     if (distance >= stack_.size()) {
         throw std::runtime_error("Stack peek out of bounds");
     }
     return stack_[stack_.size() - 1 - distance];
 }
 
+void VM::replace_top(Value&& result, size_t operands) {
+    for (size_t i = 1; i < operands; ++i) {
+        stack_.pop_back();
+    }
+    stack_.back() = std::move(result);
+}
+
+void VM::record_profile(OpCode instruction, const Chunk& chunk, size_t ip) {
+    Profile& profile = *config_.profile;
+    profile.record_opcode(instruction);
+    
+    switch (instruction) {
+        case OpCode::OP_ADD:
+        case OpCode::OP_SUBTRACT:
+        case OpCode::OP_MULTIPLY:
+        case OpCode::OP_DIVIDE:
+        case OpCode::OP_EQUAL:
+        case OpCode::OP_NOT_EQUAL:
+        case OpCode::OP_LESS:
+        case OpCode::OP_LESS_EQUAL:
+        case OpCode::OP_GREATER:
+        case OpCode::OP_GREATER_EQUAL:
+            if (stack_.size() >= 2) {
+                profile.record_operand(instruction, peek(1).get_type());
+                profile.record_operand(instruction, peek(0).get_type());
+            }
+            break;
+        case OpCode::OP_ADD_CONSTANT:
+        case OpCode::OP_SUBTRACT_CONSTANT:
+        case OpCode::OP_MULTIPLY_CONSTANT:
+            if (!stack_.empty()) {
+                profile.record_operand(instruction, peek(0).get_type());
+            }
+            if (ip < chunk.get_code().size() && chunk.get_code()[ip] < chunk.get_constants().size()) {
+                profile.record_operand(instruction, chunk.get_constant(chunk.get_code()[ip]).get_type());
+            }
+            break;
+        default:
+            break;
+    }
+}
+
 void VM::runtime_error(const std::string& message) {
     error_message_ = message;
     if (config_.debug_mode) {
@@ -263,7 +683,7 @@ void VM::runtime_error(const std::string& message) {
     }
 }
 
-void VM::debug_print(const std::string& message) const {
+void VM::debug_print(std::string_view message) const {
     if (config_.debug_mode) {
         std::cout << "[VM] " << message << std::endl;
     }
@@ -275,20 +695,28 @@ void VM::debug_print_instruction(const Chunk& chunk, size_t offset) const {
     std::cout << "[VM] " << std::setw(4) << std::setfill('0') << offset << " ";
     
     OpCode instruction = static_cast<OpCode>(chunk.get_code()[offset]);
+    std::cout << opcode_to_string(instruction);
     switch (instruction) {
-        case OpCode::OP_CONSTANT: {
+        case OpCode::OP_CONSTANT:
+        case OpCode::OP_ADD_CONSTANT:
+        case OpCode::OP_SUBTRACT_CONSTANT:
+        case OpCode::OP_MULTIPLY_CONSTANT: {
+            if (offset + 1 >= chunk.size()) break;
             uint8_t constant_index = chunk.get_code()[offset + 1];
-            std::cout << "OP_CONSTANT " << static_cast<int>(constant_index);
+            std::cout << " " << static_cast<int>(constant_index);
             if (constant_index < chunk.get_constants().size()) {
                 std::cout << " (" << chunk.get_constant(constant_index).to_string() << ")";
             }
             break;
         }
-        case OpCode::OP_RETURN:
-            std::cout << "OP_RETURN";
+        case OpCode::OP_COLUMN_LENGTH:
+        case OpCode::OP_COLUMN_GET:
+        case OpCode::OP_COLUMN_SUM:
+            if (offset + 1 < chunk.size()) {
+                std::cout << " column " << static_cast<int>(chunk.get_code()[offset + 1]);
+            }
             break;
         default:
-            std::cout << "UNKNOWN_OP";
             break;
     }
     std::cout << std::endl;
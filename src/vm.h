@@ -2,9 +2,17 @@
 
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
 #include "value.h"
 #include "chunk.h"
+#include "column.h"
+#include "stream_io.h"
+#include "profile.h"
+#include "perf_map.h"
+#include "metrics.h"
 
 namespace dacite {
 
@@ -19,6 +27,13 @@ enum class VMResult {
 struct VMConfig {
     bool debug_mode = false;
     size_t max_stack_size = 256;
+    Profile* profile = nullptr;    // Record an execution profile into this when set
+    PerfMap* perf_map = nullptr;   // Run each function through a native thunk named in this perf map when set
+    bool perf_line_markers = false; // Call dacite_perf_line on every source line change
+    Metrics* metrics = nullptr;    // Record run timings and instruction counts when set
+    std::pmr::memory_resource* memory_resource = nullptr; // Allocate the value stack from this when set
+    OutputBuffer* output = nullptr; // print writes here when set; otherwise to a buffered stdout flushed after each run
+    LineReader* input = nullptr;    // read_line reads from this when set; otherwise from stdin
 };
 
 /// Stack-based virtual machine
@@ -30,8 +45,12 @@ public:
     /// Execute a chunk of bytecode
     VMResult run(const Chunk& chunk);
     
+    /// Get the number of instructions executed by the last run; only counted
+    /// when VMConfig::metrics is set, otherwise 0
+    uint64_t get_instructions_executed() const { return instructions_executed_; }
+    
     /// Get the top value from the stack (for testing)
-    Value peek_stack_top() const;
+    const Value& peek_stack_top() const;
     
     /// Check if stack is empty
     bool is_stack_empty() const { return stack_.empty(); }
@@ -39,30 +58,75 @@ public:
     /// Get stack size
     size_t get_stack_size() const { return stack_.size(); }
     
-    /// Reset the VM state
+    /// Reset the VM state (keeps the stack's capacity)
     void reset();
     
+    /// Reserve the whole stack up front so runs never grow it
+    void reserve_stack() { stack_.reserve(config_.max_stack_size); }
+    
     /// Get any runtime error message
     const std::string& get_error_message() const { return error_message_; }
     
     /// Debug: Get stack contents as string
     std::string stack_to_string() const;
+    
+    /// Bind a host column to the lowest free slot until the binding is destroyed.
+    /// The memory is read in place, never copied, and must outlive the binding.
+    /// Returns an empty binding when all 256 slots are taken.
+    ColumnBinding bind_column(std::span<const int32_t> values);
+    ColumnBinding bind_column(std::span<const double> values);
 
 private:
+    friend class ColumnBinding;
+    
     VMConfig config_;
-    std::vector<Value> stack_;
+    std::pmr::vector<Value> stack_;
+    std::vector<Column> columns_;   // Indexed by slot; unbound slots are reused
+    std::unique_ptr<OutputBuffer> stdout_buffer_; // Created on the first print without config_.output
+    std::unique_ptr<LineReader> stdin_reader_;    // Created on the first read_line without config_.input
     std::string error_message_;
+    uint64_t instructions_executed_ = 0;
+    
+    // Execution loop behind run()
+    VMResult execute(const Chunk& chunk);
+    
+    // execute() as a plain function, the target of perf map thunks
+    static VMResult execute_entry(VM* vm, const Chunk* chunk);
     
-    // Stack operations
+    // Give values that borrow the chunk's uncounted constants their own copy,
+    // so results outlive the chunk and the constants are never counted
+    void copy_borrowed_strings();
+    
+    // Stack operations; values are moved on and off the stack and peeked by reference
     void push(const Value& value);
+    void push(Value&& value);
     Value pop();
-    Value peek(size_t distance = 0) const;
+    const Value& peek(size_t distance = 0) const;
+    
+    // Replace an operator's operands on top of the stack with its result.
+    // Handlers read the operands in place, so they are never copied off the stack.
+    void replace_top(Value&& result, size_t operands);
+    
+    // Host columns
+    ColumnBinding bind_column(Column column);
+    void unbind_column(uint8_t slot);
+    const Column* column_operand(const Chunk& chunk, size_t& ip, std::string_view instruction);
+    
+    // Builtin I/O
+    OutputBuffer& output();
+    LineReader& input();
+    
+    // Check that the `count` values below the top `above` are strings
+    bool string_operands(std::string_view builtin, size_t count, size_t above = 0);
+    
+    // Profiling
+    void record_profile(OpCode instruction, const Chunk& chunk, size_t ip);
     
     // Error handling
     void runtime_error(const std::string& message);
     
     // Debug output
-    void debug_print(const std::string& message) const;
+    void debug_print(std::string_view message) const;
     void debug_print_instruction(const Chunk& chunk, size_t offset) const;
     void debug_print_stack() const;
 };
@@ -0,0 +1,465 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../src/ast.h"
+#include "../src/lexer.h"
+#include "../src/parser.h"
+#include "../src/compiler.h"
+#include "../src/vm.h"
+#include "../src/profile.h"
+
+// Differential testing harness
+//
+// Generates random well-typed programs as ASTs, runs each one on every
+// execution engine and optimization level, and compares the outcomes against
+// a tree-walking oracle. Any disagreement is shrunk to a small reproducer.
+
+using namespace dacite;
+
+namespace {
+
+/// Result of running a program: a value or an error message
+struct Outcome {
+    std::optional<Value> value;
+    std::string error;
+
+    bool operator==(const Outcome& other) const { return value == other.value && error == other.error; }
+
+    std::string to_string() const { return value ? value->to_string() : "error: " + error; }
+};
+
+enum class ExprType { INTEGER, BOOLEAN };
+
+bool is_comparison(BinaryOperator op) {
+    return op != BinaryOperator::ADD && op != BinaryOperator::SUBTRACT &&
+           op != BinaryOperator::MULTIPLY && op != BinaryOperator::DIVIDE;
+}
+
+ExprType type_of(const Expression& expr) {
+    if (expr.type == ASTNodeType::BINARY_EXPRESSION &&
+        is_comparison(static_cast<const BinaryExpression&>(expr).operator_)) {
+        return ExprType::BOOLEAN;
+    }
+    return ExprType::INTEGER;
+}
+
+ExpressionPtr make_literal(int64_t value) {
+    return std::make_unique<IntegerLiteral>(std::to_string(value), static_cast<uint64_t>(value), SourceSpan{});
+}
+
+ExpressionPtr make_binary(ExpressionPtr left, BinaryOperator op, ExpressionPtr right) {
+    return std::make_unique<BinaryExpression>(std::move(left), op, std::move(right), SourceSpan{});
+}
+
+ExpressionPtr clone(const Expression& expr) {
+    if (expr.type == ASTNodeType::INTEGER_LITERAL) {
+        return make_literal(static_cast<int64_t>(static_cast<const IntegerLiteral&>(expr).number));
+    }
+    const auto& binary = static_cast<const BinaryExpression&>(expr);
+    return make_binary(clone(*binary.left), binary.operator_, clone(*binary.right));
+}
+
+size_t node_count(const Expression& expr) {
+    if (expr.type == ASTNodeType::INTEGER_LITERAL) return 1;
+    const auto& binary = static_cast<const BinaryExpression&>(expr);
+    return 1 + node_count(*binary.left) + node_count(*binary.right);
+}
+
+std::unique_ptr<Program> make_program(const Expression& expr) {
+    auto program = std::make_unique<Program>(SourceSpan{});
+    program->set_package_declaration(std::make_unique<PackageDeclaration>("main", SourceSpan{}));
+    auto body = std::make_unique<BlockStatement>(SourceSpan{});
+    body->add_statement(std::make_unique<ReturnStatement>(clone(expr), SourceSpan{}));
+    auto return_type = std::make_unique<Type>(type_of(expr) == ExprType::INTEGER ? "i32" : "bool", SourceSpan{});
+    program->add_declaration(std::make_unique<FunctionDeclaration>("main", std::move(return_type),
+                                                                   std::move(body), SourceSpan{}));
+    return program;
+}
+
+// === Generator ===
+
+class Generator {
+public:
+    Generator(uint64_t seed, size_t max_depth) : rng_(seed), max_depth_(max_depth) {}
+
+    ExpressionPtr generate() {
+        return generate(chance(2) ? ExprType::INTEGER : ExprType::BOOLEAN, max_depth_);
+    }
+
+private:
+    std::mt19937_64 rng_;
+    size_t max_depth_;
+
+    bool chance(uint64_t one_in) { return rng_() % one_in == 0; }
+
+    int64_t literal() {
+        // Bias towards small numbers and overflow boundaries
+        static constexpr int64_t EDGES[] = {0, 1, 2, 7, 46340, 46341, 65536, 1073741824, 2147483646, 2147483647};
+        switch (rng_() % 5) {
+            case 0:
+            case 1: return static_cast<int64_t>(rng_() % 10);
+            case 2: return static_cast<int64_t>(rng_() % 1000);
+            case 3: return EDGES[rng_() % std::size(EDGES)];
+            default: return static_cast<int64_t>(rng_() % 2147483648u);
+        }
+    }
+
+    ExpressionPtr generate(ExprType type, size_t depth) {
+        if (type == ExprType::INTEGER) {
+            if (depth == 0 || chance(4)) {
+                return make_literal(literal());
+            }
+            static constexpr BinaryOperator OPS[] = {
+                BinaryOperator::ADD, BinaryOperator::SUBTRACT, BinaryOperator::MULTIPLY, BinaryOperator::DIVIDE};
+            auto op = OPS[rng_() % std::size(OPS)];
+            auto left = generate(ExprType::INTEGER, depth - 1);
+            return make_binary(std::move(left), op, generate(ExprType::INTEGER, depth - 1));
+        }
+
+        // Booleans come from comparing integers or testing booleans for equality
+        size_t child_depth = depth > 0 ? depth - 1 : 0;
+        if (depth > 0 && chance(4)) {
+            auto op = chance(2) ? BinaryOperator::EQUAL : BinaryOperator::NOT_EQUAL;
+            auto left = generate(ExprType::BOOLEAN, child_depth);
+            return make_binary(std::move(left), op, generate(ExprType::BOOLEAN, child_depth));
+        }
+        static constexpr BinaryOperator OPS[] = {
+            BinaryOperator::EQUAL, BinaryOperator::NOT_EQUAL, BinaryOperator::LESS_THAN,
+            BinaryOperator::LESS_EQUAL, BinaryOperator::GREATER_THAN, BinaryOperator::GREATER_EQUAL};
+        auto op = OPS[rng_() % std::size(OPS)];
+        auto left = generate(ExprType::INTEGER, child_depth);
+        return make_binary(std::move(left), op, generate(ExprType::INTEGER, child_depth));
+    }
+};
+
+// === Source printing ===
+
+/// Precedence level of an expression in the grammar (higher binds tighter)
+int level(const Expression& expr) {
+    if (expr.type == ASTNodeType::INTEGER_LITERAL) return 3;
+    switch (static_cast<const BinaryExpression&>(expr).operator_) {
+        case BinaryOperator::MULTIPLY:
+        case BinaryOperator::DIVIDE: return 2;
+        case BinaryOperator::ADD:
+        case BinaryOperator::SUBTRACT: return 1;
+        default: return 0;
+    }
+}
+
+std::string operator_symbol(BinaryOperator op) {
+    switch (op) {
+        case BinaryOperator::ADD: return "+";
+        case BinaryOperator::SUBTRACT: return "-";
+        case BinaryOperator::MULTIPLY: return "*";
+        case BinaryOperator::DIVIDE: return "/";
+        case BinaryOperator::EQUAL: return "==";
+        case BinaryOperator::NOT_EQUAL: return "!=";
+        case BinaryOperator::LESS_THAN: return "<";
+        case BinaryOperator::LESS_EQUAL: return "<=";
+        case BinaryOperator::GREATER_THAN: return ">";
+        case BinaryOperator::GREATER_EQUAL: return ">=";
+    }
+    return "?";
+}
+
+/// Print an expression, parenthesizing where the (left-associative) grammar needs it.
+/// `exact` is cleared when parentheses were needed, since the parser does not accept them yet.
+std::string to_source(const Expression& expr, bool& exact) {
+    if (expr.type == ASTNodeType::INTEGER_LITERAL) {
+        return static_cast<const IntegerLiteral&>(expr).value;
+    }
+    const auto& binary = static_cast<const BinaryExpression&>(expr);
+    std::string left = to_source(*binary.left, exact);
+    std::string right = to_source(*binary.right, exact);
+    if (level(*binary.left) < level(expr)) {
+        left = "(" + left + ")";
+        exact = false;
+    }
+    if (level(*binary.right) <= level(expr)) {
+        right = "(" + right + ")";
+        exact = false;
+    }
+    return left + " " + operator_symbol(binary.operator_) + " " + right;
+}
+
+std::string program_source(const Expression& expr, bool& exact) {
+    return "package main;\n\nfn main() " + std::string(type_of(expr) == ExprType::INTEGER ? "i32" : "bool") +
+           " {\n    return " + to_source(expr, exact) + ";\n}\n";
+}
+
+// === Engines ===
+
+/// Reference semantics: 32-bit two's complement arithmetic, evaluated on the AST
+Outcome evaluate(const Expression& expr) {
+    if (expr.type == ASTNodeType::INTEGER_LITERAL) {
+        return {Value(static_cast<int32_t>(static_cast<const IntegerLiteral&>(expr).number)), ""};
+    }
+    const auto& binary = static_cast<const BinaryExpression&>(expr);
+    Outcome left = evaluate(*binary.left);
+    if (!left.value) return left;
+    Outcome right = evaluate(*binary.right);
+    if (!right.value) return right;
+
+    const Value& a = *left.value;
+    const Value& b = *right.value;
+    auto wrap = [](int64_t value) { return Value(static_cast<int32_t>(static_cast<uint32_t>(value))); };
+    switch (binary.operator_) {
+        case BinaryOperator::ADD: return {wrap(int64_t{a.as_integer()} + b.as_integer()), ""};
+        case BinaryOperator::SUBTRACT: return {wrap(int64_t{a.as_integer()} - b.as_integer()), ""};
+        case BinaryOperator::MULTIPLY: return {wrap(int64_t{a.as_integer()} * b.as_integer()), ""};
+        case BinaryOperator::DIVIDE:
+            if (b.as_integer() == 0) return {std::nullopt, "Division by zero"};
+            return {wrap(int64_t{a.as_integer()} / b.as_integer()), ""};
+        case BinaryOperator::EQUAL: return {Value(a == b), ""};
+        case BinaryOperator::NOT_EQUAL: return {Value(a != b), ""};
+        case BinaryOperator::LESS_THAN: return {Value(a.as_integer() < b.as_integer()), ""};
+        case BinaryOperator::LESS_EQUAL: return {Value(a.as_integer() <= b.as_integer()), ""};
+        case BinaryOperator::GREATER_THAN: return {Value(a.as_integer() > b.as_integer()), ""};
+        case BinaryOperator::GREATER_EQUAL: return {Value(a.as_integer() >= b.as_integer()), ""};
+    }
+    return {std::nullopt, "Unknown operator"};
+}
+
+Outcome run_chunk(const Chunk& chunk, Profile* profile = nullptr) {
+    VMConfig config;
+    config.profile = profile;
+    VM vm(config);
+    if (vm.run(chunk) != VMResult::OK) {
+        return {std::nullopt, vm.get_error_message()};
+    }
+    if (vm.is_stack_empty()) {
+        return {std::nullopt, "Empty stack"};
+    }
+    return {vm.peek_stack_top(), ""};
+}
+
+/// Optimization levels: no profile, the program's own profile, and a profile
+/// that marks every arithmetic opcode integer-only (fusing every eligible node)
+enum class OptLevel { O0, O1, O2 };
+
+constexpr const char* OPT_LEVEL_NAMES[] = {"O0", "O1", "O2"};
+
+Profile integer_only_profile() {
+    Profile profile;
+    for (OpCode opcode : {OpCode::OP_ADD, OpCode::OP_SUBTRACT, OpCode::OP_MULTIPLY}) {
+        profile.record_opcode(opcode);
+        profile.record_operand(opcode, ValueType::INTEGER);
+    }
+    return profile;
+}
+
+std::optional<Profile> profile_for(OptLevel level, const Program& program) {
+    if (level == OptLevel::O0) return std::nullopt;
+    if (level == OptLevel::O2) return integer_only_profile();
+
+    Compiler compiler;
+    Chunk chunk;
+    Profile profile;
+    if (compiler.compile(program, chunk) == CompileResult::OK) {
+        run_chunk(chunk, &profile);
+    }
+    return profile;
+}
+
+/// Whole-program compile, executed by VM::run
+Outcome run_program(const Program& program, OptLevel level) {
+    auto profile = profile_for(level, program);
+    CompilerConfig config;
+    config.profile = profile ? &*profile : nullptr;
+    Compiler compiler(config);
+    Chunk chunk;
+    if (compiler.compile(program, chunk) != CompileResult::OK) {
+        return {std::nullopt, "Compile error: " + compiler.get_error_message()};
+    }
+    return run_chunk(chunk);
+}
+
+/// Expression compile used by the REPL, executed by VM::run
+Outcome run_standalone(const Program& program, OptLevel level) {
+    auto profile = profile_for(level, program);
+    CompilerConfig config;
+    config.profile = profile ? &*profile : nullptr;
+    Compiler compiler(config);
+    Chunk chunk;
+    const auto& function = static_cast<const FunctionDeclaration&>(*program.declarations.front());
+    const auto& ret = static_cast<const ReturnStatement&>(*function.body->statements.front());
+    if (compiler.compile_standalone_expression(*ret.expression, chunk) != CompileResult::OK) {
+        return {std::nullopt, "Compile error: " + compiler.get_error_message()};
+    }
+    return run_chunk(chunk);
+}
+
+/// Print to source and run the full pipeline; only applies when the grammar can express the tree
+std::optional<Outcome> run_source(const Expression& expr) {
+    bool exact = true;
+    std::string source = program_source(expr, exact);
+    if (!exact) {
+        return std::nullopt;
+    }
+    Lexer lexer(source);
+    Parser parser(lexer.tokenize_all());
+    auto program = parser.parse();
+    if (lexer.has_errors() || parser.has_errors()) {
+        return Outcome{std::nullopt, "Source did not parse"};
+    }
+    return run_program(*program, OptLevel::O0);
+}
+
+/// First disagreement with the oracle, if any
+struct Mismatch {
+    std::string engine;
+    Outcome expected;
+    Outcome actual;
+};
+
+std::optional<Mismatch> check(const Expression& expr) {
+    Outcome expected = evaluate(expr);
+    auto program = make_program(expr);
+
+    for (auto level : {OptLevel::O0, OptLevel::O1, OptLevel::O2}) {
+        std::string suffix = std::string("-") + OPT_LEVEL_NAMES[static_cast<size_t>(level)];
+        Outcome actual = run_program(*program, level);
+        if (!(actual == expected)) return Mismatch{"vm" + suffix, expected, actual};
+        actual = run_standalone(*program, level);
+        if (!(actual == expected)) return Mismatch{"standalone" + suffix, expected, actual};
+    }
+    if (auto actual = run_source(expr); actual && !(*actual == expected)) {
+        return Mismatch{"source-O0", expected, *actual};
+    }
+    return std::nullopt;
+}
+
+// === Shrinking ===
+
+/// Smaller variants of `expr`: a node replaced by a same-typed child,
+/// an integer subtree folded to a literal, or a literal moved towards zero
+void candidates(const Expression& expr, const std::function<ExpressionPtr(ExpressionPtr)>& rebuild,
+                std::vector<ExpressionPtr>& out) {
+    if (expr.type == ASTNodeType::INTEGER_LITERAL) {
+        auto value = static_cast<int64_t>(static_cast<const IntegerLiteral&>(expr).number);
+        for (int64_t smaller : {int64_t{0}, int64_t{1}, value / 2, value - 1}) {
+            if (smaller >= 0 && smaller < value) {
+                out.push_back(rebuild(make_literal(smaller)));
+            }
+        }
+        return;
+    }
+
+    const auto& binary = static_cast<const BinaryExpression&>(expr);
+    for (const Expression* child : {binary.left.get(), binary.right.get()}) {
+        if (type_of(*child) == type_of(expr)) {
+            out.push_back(rebuild(clone(*child)));
+        }
+    }
+    if (type_of(expr) == ExprType::INTEGER) {
+        Outcome folded = evaluate(expr);
+        if (folded.value && folded.value->as_integer() >= 0) {
+            out.push_back(rebuild(make_literal(folded.value->as_integer())));
+        }
+    }
+
+    candidates(*binary.left, [&](ExpressionPtr left) {
+        return rebuild(make_binary(std::move(left), binary.operator_, clone(*binary.right)));
+    }, out);
+    candidates(*binary.right, [&](ExpressionPtr right) {
+        return rebuild(make_binary(clone(*binary.left), binary.operator_, std::move(right)));
+    }, out);
+}
+
+ExpressionPtr shrink(ExpressionPtr expr) {
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        std::vector<ExpressionPtr> smaller;
+        candidates(*expr, [](ExpressionPtr e) { return e; }, smaller);
+        for (auto& candidate : smaller) {
+            if (check(*candidate)) {
+                expr = std::move(candidate);
+                progress = true;
+                break;
+            }
+        }
+    }
+    return expr;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "Compares every engine and optimization level against an AST oracle on random programs.\n"
+              << "\n"
+              << "Options:\n"
+              << "  --seed N         Random seed (default: 1)\n"
+              << "  --iterations N   Number of programs to generate (default: 2000)\n"
+              << "  --max-depth N    Maximum expression depth (default: 5)\n"
+              << "  --help           Show this message\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = 1;
+    size_t iterations = 2000;
+    size_t max_depth = 5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if ((arg == "--seed" || arg == "--iterations" || arg == "--max-depth") && i + 1 < argc) {
+            try {
+                uint64_t value = std::stoull(argv[++i]);
+                if (arg == "--seed") seed = value;
+                else if (arg == "--iterations") iterations = value;
+                else max_depth = value;
+            } catch (const std::exception&) {
+                std::cerr << "Error: " << arg << " expects a number" << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::cout << "Running differential tests (seed " << seed << ", " << iterations << " programs)..." << std::endl;
+    Generator generator(seed, max_depth);
+    size_t errors = 0;
+    size_t parsed = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        auto expr = generator.generate();
+        if (!evaluate(*expr).value) errors++;
+        bool exact = true;
+        program_source(*expr, exact);
+        if (exact) parsed++;
+
+        auto mismatch = check(*expr);
+        if (!mismatch) continue;
+
+        size_t original_nodes = node_count(*expr);
+        expr = shrink(std::move(expr));
+        mismatch = check(*expr);
+        std::cout << "MISMATCH in program " << i << " (shrunk from " << original_nodes << " to "
+                  << node_count(*expr) << " nodes)" << std::endl;
+        std::cout << "  engine:   " << mismatch->engine << std::endl;
+        std::cout << "  expected: " << mismatch->expected.to_string() << std::endl;
+        std::cout << "  actual:   " << mismatch->actual.to_string() << std::endl;
+        std::cout << "  AST:      " << expr->to_string() << std::endl;
+        bool exact_source = true;
+        std::string source = program_source(*expr, exact_source);
+        std::cout << "  source" << (exact_source ? ":" : " (needs parentheses):") << std::endl << source;
+        std::cout << "Reproduce with --seed " << seed << " --iterations " << i + 1 << std::endl;
+        return 1;
+    }
+
+    std::cout << "All " << iterations << " programs agree across engines ("
+              << errors << " runtime errors, " << parsed << " also checked through the parser)" << std::endl;
+    return 0;
+}
\ No newline at end of file
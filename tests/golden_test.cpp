@@ -0,0 +1,361 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/lexer.h"
+#include "../src/parser.h"
+#include "../src/compiler.h"
+#include "../src/vm.h"
+#include "../src/json.h"
+
+// Golden-file test runner
+//
+// Discovers .dt files carrying expectation annotations and runs each one
+// through the pipeline on a pool of worker threads:
+//
+//   // expect: <value>                   Program runs and returns <value>
+//   // expect-error: <stage>[: <text>]   Pipeline fails at <stage> (lex, parse,
+//                                         compile, run) with a message containing <text>
+//   // run: <stage>                      Stop after <stage>, expecting no errors
+//
+// Files without annotations are skipped. All failures are reported, not just the first.
+
+namespace fs = std::filesystem;
+using namespace dacite;
+
+namespace {
+
+enum class Stage { LEX, PARSE, COMPILE, RUN };
+
+constexpr const char* STAGE_NAMES[] = {"lex", "parse", "compile", "run"};
+
+std::optional<Stage> parse_stage(std::string_view name) {
+    for (size_t i = 0; i < std::size(STAGE_NAMES); ++i) {
+        if (name == STAGE_NAMES[i]) {
+            return static_cast<Stage>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+/// Expectations parsed from a file's annotations
+struct GoldenTest {
+    fs::path path;
+    std::string source;
+    std::optional<std::string> expect;   // Expected result value
+    std::optional<Stage> error_stage;    // Stage expected to fail
+    std::string error_text;              // Substring of the expected error message
+    Stage last_stage = Stage::RUN;       // Last stage to run
+    std::string annotation_error;        // Malformed annotation, reported as a failure
+};
+
+/// Outcome of one test
+struct GoldenResult {
+    bool passed = false;
+    std::string message;
+    double ms = 0.0;
+};
+
+/// What the pipeline actually did
+struct PipelineOutcome {
+    std::optional<Stage> error_stage;
+    std::string error_message;
+    std::string value;
+};
+
+std::string trim(std::string_view text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string_view::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return std::string(text.substr(start, end - start + 1));
+}
+
+bool read_annotations(GoldenTest& test) {
+    bool annotated = false;
+    std::istringstream lines(test.source);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::string text = trim(line);
+        if (!text.starts_with("//")) continue;
+        text = trim(std::string_view(text).substr(2));
+
+        if (text.starts_with("expect:")) {
+            test.expect = trim(std::string_view(text).substr(7));
+            annotated = true;
+        } else if (text.starts_with("expect-error:")) {
+            std::string spec = trim(std::string_view(text).substr(13));
+            size_t colon = spec.find(':');
+            test.error_stage = parse_stage(trim(std::string_view(spec).substr(0, colon)));
+            if (colon != std::string::npos) {
+                test.error_text = trim(std::string_view(spec).substr(colon + 1));
+            }
+            if (!test.error_stage) {
+                test.annotation_error = "Unknown stage in '" + text + "'";
+            }
+            annotated = true;
+        } else if (text.starts_with("run:")) {
+            auto stage = parse_stage(trim(std::string_view(text).substr(4)));
+            if (stage) {
+                test.last_stage = *stage;
+            } else {
+                test.annotation_error = "Unknown stage in '" + text + "'";
+            }
+            annotated = true;
+        }
+    }
+    if (test.expect && test.error_stage) {
+        test.annotation_error = "Both expect and expect-error given";
+    }
+    return annotated;
+}
+
+template <typename Errors>
+std::string first_error(const Errors& errors) {
+    const auto& error = errors.front();
+    return std::to_string(error.span.start.line) + ":" + std::to_string(error.span.start.column) +
+           ": " + error.message;
+}
+
+PipelineOutcome run_pipeline(const GoldenTest& test) {
+    PipelineOutcome outcome;
+
+    Lexer lexer(test.source);
+    auto tokens = lexer.tokenize_all();
+    if (lexer.has_errors()) {
+        outcome.error_stage = Stage::LEX;
+        outcome.error_message = first_error(lexer.get_errors());
+        return outcome;
+    }
+    if (test.last_stage == Stage::LEX) return outcome;
+
+    Parser parser(std::move(tokens));
+    auto program = parser.parse();
+    if (parser.has_errors()) {
+        outcome.error_stage = Stage::PARSE;
+        outcome.error_message = first_error(parser.get_errors());
+        return outcome;
+    }
+    if (test.last_stage == Stage::PARSE) return outcome;
+
+    Compiler compiler;
+    Chunk chunk;
+    if (compiler.compile(*program, chunk) != CompileResult::OK) {
+        outcome.error_stage = Stage::COMPILE;
+        outcome.error_message = compiler.get_error_message();
+        return outcome;
+    }
+    if (test.last_stage == Stage::COMPILE) return outcome;
+
+    VM vm;
+    if (vm.run(chunk) != VMResult::OK) {
+        outcome.error_stage = Stage::RUN;
+        outcome.error_message = vm.get_error_message();
+        return outcome;
+    }
+    outcome.value = vm.is_stack_empty() ? "nil" : vm.peek_stack_top().to_string();
+    return outcome;
+}
+
+GoldenResult run_test(const GoldenTest& test) {
+    GoldenResult result;
+    if (!test.annotation_error.empty()) {
+        result.message = test.annotation_error;
+        return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    PipelineOutcome outcome = run_pipeline(test);
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::string actual = outcome.error_stage
+        ? std::string(STAGE_NAMES[static_cast<size_t>(*outcome.error_stage)]) + " error: " + outcome.error_message
+        : "value " + outcome.value;
+
+    if (test.error_stage) {
+        result.passed = outcome.error_stage == test.error_stage &&
+                        outcome.error_message.find(test.error_text) != std::string::npos;
+        if (!result.passed) {
+            result.message = "expected " + std::string(STAGE_NAMES[static_cast<size_t>(*test.error_stage)]) +
+                             " error containing '" + test.error_text + "', got " + actual;
+        }
+    } else if (outcome.error_stage) {
+        result.message = "unexpected " + actual;
+    } else if (test.expect) {
+        result.passed = outcome.value == *test.expect;
+        if (!result.passed) {
+            result.message = "expected value " + *test.expect + ", got " + actual;
+        }
+    } else {
+        result.passed = true;
+    }
+    return result;
+}
+
+std::vector<GoldenTest> discover(const std::vector<fs::path>& roots, size_t& skipped) {
+    std::vector<fs::path> files;
+    for (const auto& root : roots) {
+        if (fs::is_regular_file(root)) {
+            files.push_back(root);
+            continue;
+        }
+        for (const auto& entry : fs::recursive_directory_iterator(root)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".dt") {
+                files.push_back(entry.path());
+            }
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<GoldenTest> tests;
+    for (const auto& file : files) {
+        std::ifstream input(file);
+        GoldenTest test;
+        test.path = file;
+        test.source.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        if (read_annotations(test)) {
+            tests.push_back(std::move(test));
+        } else {
+            skipped++;
+        }
+    }
+    return tests;
+}
+
+bool write_timings(const std::string& path, const std::vector<GoldenTest>& tests,
+                   const std::vector<GoldenResult>& results) {
+    Json::Array entries;
+    for (size_t i = 0; i < tests.size(); ++i) {
+        entries.push_back(Json::Object{
+            {"test", tests[i].path.string()},
+            {"passed", results[i].passed},
+            {"ms", results[i].ms},
+        });
+    }
+    std::ofstream output(path);
+    output << Json(Json::Object{{"tests", std::move(entries)}}).dump() << "\n";
+    return static_cast<bool>(output);
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options] [dir-or-file...]\n"
+              << "\n"
+              << "Runs annotated .dt golden files (default: tests/) in parallel.\n"
+              << "\n"
+              << "Options:\n"
+              << "  -j N             Number of worker threads (default: hardware concurrency)\n"
+              << "  --timings FILE   Write per-test timings as JSON to FILE\n"
+              << "  --slow-ms MS     Flag tests slower than MS milliseconds (default: 100)\n"
+              << "  --help           Show this message\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<fs::path> roots;
+    size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::optional<std::string> timings_path;
+    double slow_ms = 100.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if ((arg == "-j" || arg == "--timings" || arg == "--slow-ms") && i + 1 < argc) {
+            std::string value = argv[++i];
+            try {
+                if (arg == "-j") {
+                    jobs = std::max<size_t>(1, std::stoul(value));
+                } else if (arg == "--slow-ms") {
+                    slow_ms = std::stod(value);
+                } else {
+                    timings_path = value;
+                }
+            } catch (const std::exception&) {
+                std::cerr << "Error: " << arg << " expects a number" << std::endl;
+                return 1;
+            }
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Error: Unknown option " << arg << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            roots.emplace_back(arg);
+        }
+    }
+    if (roots.empty()) {
+        roots.emplace_back("tests");
+    }
+    for (const auto& root : roots) {
+        if (!fs::exists(root)) {
+            std::cerr << "Error: " << root.string() << " does not exist" << std::endl;
+            return 1;
+        }
+    }
+
+    size_t skipped = 0;
+    std::vector<GoldenTest> tests = discover(roots, skipped);
+    std::vector<GoldenResult> results(tests.size());
+
+    // Workers pull the next test index until the corpus is exhausted
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next{0};
+    std::vector<std::jthread> workers;
+    for (size_t w = 0; w < std::min(jobs, tests.size()); ++w) {
+        workers.emplace_back([&] {
+            for (size_t i = next.fetch_add(1); i < tests.size(); i = next.fetch_add(1)) {
+                results[i] = run_test(tests[i]);
+            }
+        });
+    }
+    workers.clear();
+    double total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t failed = 0;
+    std::cout << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < tests.size(); ++i) {
+        const auto& result = results[i];
+        std::cout << (result.passed ? "PASS " : "FAIL ") << tests[i].path.string()
+                  << " (" << result.ms << " ms)";
+        if (result.ms > slow_ms) {
+            std::cout << " SLOW";
+        }
+        std::cout << std::endl;
+        if (!result.passed) {
+            std::cout << "     " << result.message << std::endl;
+            failed++;
+        }
+    }
+
+    // Slowest tests first so timing regressions stand out
+    std::vector<size_t> order(tests.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return results[a].ms > results[b].ms; });
+    if (!order.empty()) {
+        std::cout << std::endl << "Slowest tests:" << std::endl;
+        for (size_t i = 0; i < std::min<size_t>(5, order.size()); ++i) {
+            std::cout << "  " << std::setw(10) << results[order[i]].ms << " ms  "
+                      << tests[order[i]].path.string() << std::endl;
+        }
+    }
+
+    if (timings_path && !write_timings(*timings_path, tests, results)) {
+        std::cerr << "Error: Could not write timings to " << *timings_path << std::endl;
+        return 1;
+    }
+
+    std::cout << std::endl << tests.size() - failed << " passed, " << failed << " failed, "
+              << skipped << " skipped (no annotations) in " << total_ms << " ms on "
+              << std::min(jobs, std::max<size_t>(1, tests.size())) << " threads" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
\ No newline at end of file
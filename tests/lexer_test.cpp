@@ -2,7 +2,10 @@
 #include <cassert>
 #include <vector>
 #include <string>
+#include <thread>
 #include "../src/lexer.h"
+#include "../src/string_kernels.h"
+#include "../src/unicode.h"
 
 // Simple test framework
 #define TEST(name) void test_##name()
@@ -54,12 +57,58 @@ TEST(integers) {
     Lexer lexer(source, config);
     
     std::vector<std::string> expected = {"123", "0x1F", "0b1010", "0777"};
+    std::vector<uint64_t> values = {123, 31, 10, 511};
     
-    for (const auto& expected_value : expected) {
+    for (size_t i = 0; i < expected.size(); ++i) {
         auto token = lexer.next_token();
         ASSERT_EQ(token.type, TokenType::INTEGER_LITERAL);
-        ASSERT_EQ(token.value, expected_value);
+        ASSERT_EQ(token.value, expected[i]);
+        ASSERT_EQ(token.integer_value(), values[i]);
+    }
+}
+
+TEST(long_integers) {
+    // Decimal literals of eight digits and more take the word-at-a-time path
+    std::string source = "12345678 1234567890123 18446744073709551615 0xFFFFFFFFFFFFFFFF 00000000000000000001";
+    LexerConfig config;
+    Lexer lexer(source, config);
+    
+    std::vector<uint64_t> values = {12345678, 1234567890123, UINT64_MAX, UINT64_MAX, 1};
+    for (uint64_t value : values) {
+        auto token = lexer.next_token();
+        ASSERT_EQ(token.type, TokenType::INTEGER_LITERAL);
+        ASSERT_EQ(token.integer_value(), value);
+    }
+    
+    // Every digit position of the eight-digit step
+    for (uint64_t value = 1; value < 100000000000000000; value = value * 10 + value % 7 + 1) {
+        std::string digits = std::to_string(value);
+        Lexer single(digits, config);
+        auto token = single.next_token();
+        ASSERT_EQ(token.integer_value(), value);
+    }
+}
+
+TEST(integer_literal_errors) {
+    LexerConfig config;
+    for (std::string source : {"18446744073709551616", "99999999999999999999999", "0x10000000000000000",
+                               "0b11111111111111111111111111111111111111111111111111111111111111111"}) {
+        Lexer lexer(source, config);
+        auto token = lexer.next_token();
+        ASSERT_EQ(token.type, TokenType::ERROR);
+        ASSERT_EQ(token.value, "Integer literal too large");
+        ASSERT_TRUE(lexer.at_end());
     }
+    
+    Lexer hex("0x;", config);
+    auto token = hex.next_token();
+    ASSERT_EQ(token.value, "Expected hexadecimal digits after '0x'");
+    token = hex.next_token();
+    ASSERT_EQ(token.type, TokenType::SEMICOLON);
+    
+    Lexer binary("0b2", config);
+    token = binary.next_token();
+    ASSERT_EQ(token.value, "Expected binary digits after '0b'");
 }
 
 TEST(floats) {
@@ -68,12 +117,19 @@ TEST(floats) {
     Lexer lexer(source, config);
     
     std::vector<std::string> expected = {"3.14", "0.5", "123.456"};
+    std::vector<double> values = {3.14, 0.5, 123.456};
     
-    for (const auto& expected_value : expected) {
+    for (size_t i = 0; i < expected.size(); ++i) {
         auto token = lexer.next_token();
         ASSERT_EQ(token.type, TokenType::FLOAT_LITERAL);
-        ASSERT_EQ(token.value, expected_value);
+        ASSERT_EQ(token.value, expected[i]);
+        ASSERT_EQ(token.float_value(), values[i]);
     }
+    
+    std::string huge_source = std::string(400, '9') + ".0";
+    Lexer huge(huge_source, config);
+    auto token = huge.next_token();
+    ASSERT_EQ(token.value, "Float literal out of range");
 }
 
 TEST(strings) {
@@ -90,6 +146,20 @@ TEST(strings) {
     }
 }
 
+TEST(utf8_strings) {
+    std::string source = "\"caf\xC3\xA9 \xE2\x82\xAC\\t\xF0\x9F\x98\x80\" \"bad \xC0\xAF\"";
+    Lexer lexer(source);
+    
+    auto token = lexer.next_token();
+    ASSERT_EQ(token.type, TokenType::STRING_LITERAL);
+    ASSERT_EQ(token.value, "caf\xC3\xA9 \xE2\x82\xAC\t\xF0\x9F\x98\x80");
+    
+    // Overlong encodings are rejected
+    token = lexer.next_token();
+    ASSERT_EQ(token.type, TokenType::ERROR);
+    ASSERT_EQ(lexer.get_errors().back().message, "Invalid UTF-8 in string literal");
+}
+
 TEST(characters) {
     std::string source = "'a' '\\n' '\\\\' '\\''";
     LexerConfig config;
@@ -177,6 +247,90 @@ TEST(source_positions) {
     ASSERT_EQ(token3.span.start.column, 5);
 }
 
+TEST(unicode_identifiers) {
+    // "größe + 名前 // café" with a comment in the middle
+    std::string source = "gr\xC3\xB6\xC3\x9F" "e + \xE5\x90\x8D\xE5\x89\x8D /* \xE2\x80\x94 */ x\xCC\x81 // caf\xC3\xA9\n\xE2\x82\xAC";
+    Lexer lexer(source);
+    
+    auto size = lexer.next_token();
+    ASSERT_EQ(size.type, TokenType::IDENTIFIER);
+    ASSERT_EQ(size.value, "gr\xC3\xB6\xC3\x9F" "e");
+    ASSERT_EQ(size.span.end.column, 6);
+    
+    auto plus = lexer.next_token();
+    ASSERT_EQ(plus.span.start.column, 7);
+    
+    auto name = lexer.next_token();
+    ASSERT_EQ(name.type, TokenType::IDENTIFIER);
+    ASSERT_EQ(name.span.start.column, 9);
+    ASSERT_EQ(name.span.end.column, 11);
+    
+    // Combining marks continue an identifier but cannot start one
+    auto accented = lexer.next_token();
+    ASSERT_EQ(accented.type, TokenType::IDENTIFIER);
+    ASSERT_EQ(accented.value, "x\xCC\x81");
+    ASSERT_EQ(accented.span.start.column, 20);
+    
+    auto euro = lexer.next_token();
+    ASSERT_EQ(euro.type, TokenType::ERROR);
+    ASSERT_EQ(lexer.get_errors().back().message, "Unexpected character '\xE2\x82\xAC'");
+    ASSERT_EQ(euro.span.start.line, 2);
+    ASSERT_EQ(euro.span.end.column, 2);
+    
+    // The token buffer decodes the same code-point columns
+    TokenBuffer buffer;
+    Lexer(source).tokenize_all(buffer);
+    auto expected = Lexer(source).tokenize_all();
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(buffer.span(i), expected[i].span);
+    }
+}
+
+TEST(invalid_utf8_source) {
+    Lexer stray("a \x80 b");
+    auto token = stray.next_token();
+    ASSERT_EQ(token.type, TokenType::IDENTIFIER);
+    token = stray.next_token();
+    ASSERT_EQ(token.type, TokenType::ERROR);
+    ASSERT_EQ(stray.get_errors().back().message, "Invalid UTF-8 in source");
+    token = stray.next_token();
+    ASSERT_EQ(token.value, "b");
+    
+    // Skipped comments still report their errors
+    Lexer comment("// \xED\xA0\x80\nx");
+    token = comment.next_token();
+    ASSERT_EQ(token.value, "x");
+    ASSERT_EQ(comment.get_errors().back().message, "Invalid UTF-8 in comment");
+}
+
+TEST(utf8_kernels) {
+    ASSERT_EQ(text::ascii_prefix_length(std::string(70, 'a')), 70);
+    for (size_t at : {0, 5, 31, 32, 33, 63, 64, 69}) {
+        std::string source(70, 'a');
+        source[at] = '\xC3';
+        ASSERT_EQ(text::ascii_prefix_length(source), at);
+    }
+    ASSERT_EQ(text::count_code_points(""), 0);
+    ASSERT_EQ(text::count_code_points(std::string(20, 'a') + "\xE5\x90\x8D\xF0\x9F\x98\x80" + std::string(20, 'b')), 42);
+    
+    auto euro = text::decode_utf8("x\xE2\x82\xAC", 1);
+    ASSERT_EQ(euro.value, U'€');
+    ASSERT_EQ(euro.length, 3);
+    ASSERT_EQ(text::decode_utf8("\xF0\x9F\x98\x80", 0).value, U'\U0001F600');
+    ASSERT_EQ(text::decode_utf8("\xC1\xBF", 0).length, 0);
+    ASSERT_EQ(text::decode_utf8("\xE2\x82", 0).length, 0);
+    
+    ASSERT_TRUE(unicode::is_xid_start(U'é'));    // é
+    ASSERT_TRUE(unicode::is_xid_start(U'名'));    // CJK
+    ASSERT_TRUE(unicode::is_xid_start(U'\U00020000')); // CJK Extension B
+    ASSERT_FALSE(unicode::is_xid_start(U'́'));   // Combining acute accent
+    ASSERT_TRUE(unicode::is_xid_continue(U'́'));
+    ASSERT_FALSE(unicode::is_xid_start(U'€'));   // Euro sign
+    ASSERT_FALSE(unicode::is_xid_continue(U' ')); // No-break space
+    ASSERT_FALSE(unicode::is_xid_start('1'));
+    ASSERT_TRUE(unicode::is_xid_continue('1'));
+}
+
 TEST(error_handling) {
     std::string source = "\"unterminated string";
     LexerConfig config;
@@ -208,21 +362,120 @@ TEST(whitespace_emission) {
     ASSERT_EQ(token4.value, "\t");
 }
 
+TEST(token_buffer_round_trip) {
+    std::string source =
+        "package main;\n"
+        "fn main() i32 {\n"
+        "    // comment\n"
+        "    return 0x1F + 3.5 * \"a\\tb\" - 'c'; /* multi\n line */\n"
+        "    $ \"bad\\q\"\n"
+        "}\n";
+    LexerConfig config;
+    config.emit_comments = true;
+    auto expected = Lexer(source, config).tokenize_all();
+    
+    TokenBuffer buffer;
+    Lexer(source, config).tokenize_all(buffer);
+    ASSERT_EQ(buffer.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(buffer.token(i), expected[i]);
+    }
+    ASSERT_EQ(buffer.type(buffer.size()), TokenType::EOF_TOKEN);
+    
+    // Buffers built from materialized tokens keep values and spans in side tables
+    TokenBuffer detached;
+    for (const auto& token : expected) {
+        detached.push_back(token);
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(detached.token(i), expected[i]);
+    }
+    
+    // Decoded literal values come back through the accessors
+    size_t integer = 0;
+    while (buffer.type(integer) != TokenType::INTEGER_LITERAL) integer++;
+    ASSERT_EQ(buffer.integer_value(integer), 31u);
+    ASSERT_EQ(buffer.float_value(integer + 2), 3.5);
+    ASSERT_EQ(detached.integer_value(integer), 31u);
+    ASSERT_EQ(buffer.integer_value(0), 0u);
+}
+
+TEST(token_buffer_size) {
+    std::string source;
+    for (int i = 0; i < 1000; ++i) {
+        source += "return value_" + std::to_string(i) + " + " + std::to_string(i) + ";\n";
+    }
+    TokenBuffer buffer;
+    Lexer(source).tokenize_all(buffer);
+    ASSERT_EQ(buffer.size(), 5001);
+    ASSERT_TRUE(buffer.token_bytes() < 8 * buffer.size());
+    ASSERT_EQ(buffer.value(1), "value_0");
+    ASSERT_EQ(buffer.span(4999).start.line, 1000);
+}
+
+TEST(token_buffer_non_ascii_columns) {
+    // Long lines of multi-byte identifiers cross many column checkpoints
+    std::string source;
+    for (int line = 0; line < 4; ++line) {
+        source += "return";
+        for (int i = 0; i < 40 + line * 7; ++i) {
+            source += " é" + std::to_string(i) + " + 日本" + std::to_string(i);
+        }
+        source += ";\n";
+    }
+    auto expected = Lexer(source).tokenize_all();
+    TokenBuffer buffer;
+    Lexer(source).tokenize_all(buffer);
+    ASSERT_EQ(buffer.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(buffer.span(i), expected[i].span);
+    }
+}
+
+TEST(token_buffer_shared_reads) {
+    std::string source = "fn main() i32 {\n    return \"héllo\" + 1;\n}\n";
+    auto expected = Lexer(source).tokenize_all();
+    TokenBuffer filled;
+    Lexer(source).tokenize_all(filled);
+    
+    // The line table is built with the buffer, so concurrent readers share it without writing
+    const TokenBuffer& buffer = filled;
+    auto read_all = [&] {
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(buffer.token(i), expected[i]);
+        }
+    };
+    std::thread first(read_all);
+    std::thread second(read_all);
+    first.join();
+    second.join();
+}
+
 int main() {
     std::cout << "Running Lexer Tests..." << std::endl;
     
     RUN_TEST(keywords);
     RUN_TEST(identifiers);
     RUN_TEST(integers);
+    RUN_TEST(long_integers);
+    RUN_TEST(integer_literal_errors);
     RUN_TEST(floats);
     RUN_TEST(strings);
+    RUN_TEST(utf8_strings);
     RUN_TEST(characters);
     RUN_TEST(operators);
     RUN_TEST(punctuation);
     RUN_TEST(comments);
     RUN_TEST(source_positions);
+    RUN_TEST(unicode_identifiers);
+    RUN_TEST(invalid_utf8_source);
+    RUN_TEST(utf8_kernels);
     RUN_TEST(error_handling);
     RUN_TEST(whitespace_emission);
+    RUN_TEST(token_buffer_round_trip);
+    RUN_TEST(token_buffer_size);
+    RUN_TEST(token_buffer_non_ascii_columns);
+    RUN_TEST(token_buffer_shared_reads);
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
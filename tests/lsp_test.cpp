@@ -0,0 +1,215 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "../src/json.h"
+#include "../src/language_server.h"
+
+// Simple test framework (consistent with existing tests)
+#define TEST(name) void test_##name()
+#define ASSERT_EQ(a, b) assert((a) == (b))
+#define ASSERT_TRUE(a) assert(a)
+#define ASSERT_FALSE(a) assert(!(a))
+#define ASSERT_NOT_NULL(a) assert((a) != nullptr)
+#define RUN_TEST(name) do { \
+    std::cout << "Running " #name "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl; \
+} while(0)
+
+using namespace dacite;
+
+// Helper to build a didOpen notification
+std::string did_open(const std::string& uri, const std::string& text) {
+    return Json(Json::Object{
+        {"jsonrpc", "2.0"},
+        {"method", "textDocument/didOpen"},
+        {"params", Json::Object{{"textDocument", Json::Object{
+            {"uri", uri}, {"languageId", "dacite"}, {"version", 1}, {"text", text}}}}},
+    }).dump();
+}
+
+// Helper to build a definition request
+std::string definition(int id, const std::string& uri, int line, int character) {
+    return Json(Json::Object{
+        {"jsonrpc", "2.0"},
+        {"id", id},
+        {"method", "textDocument/definition"},
+        {"params", Json::Object{
+            {"textDocument", Json::Object{{"uri", uri}}},
+            {"position", Json::Object{{"line", line}, {"character", character}}}}},
+    }).dump();
+}
+
+// Helper to parse the single message a server call produced
+Json single_message(const std::vector<std::string>& messages) {
+    ASSERT_EQ(messages.size(), 1);
+    auto parsed = Json::parse(messages[0]);
+    ASSERT_TRUE(parsed.has_value());
+    return *parsed;
+}
+
+// === JSON Tests ===
+
+TEST(json_round_trip) {
+    std::string text = R"({"a":1,"b":[true,false,null],"c":"x\"y\n","d":-2.5,"e":{}})";
+    auto parsed = Json::parse(text);
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->dump(), text);
+    ASSERT_EQ(parsed->get("a")->as_number(), 1.0);
+    ASSERT_EQ(parsed->get("c")->as_string(), "x\"y\n");
+    ASSERT_TRUE(parsed->get("b")->as_array()[2].is_null());
+    ASSERT_TRUE(parsed->get("missing") == nullptr);
+}
+
+TEST(json_unicode_escapes) {
+    auto parsed = Json::parse(R"("\u00e9\ud83d\ude00")");
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->as_string(), "\xC3\xA9\xF0\x9F\x98\x80");
+}
+
+TEST(json_malformed) {
+    ASSERT_FALSE(Json::parse("").has_value());
+    ASSERT_FALSE(Json::parse("{").has_value());
+    ASSERT_FALSE(Json::parse("[1,]").has_value());
+    ASSERT_FALSE(Json::parse("{\"a\" 1}").has_value());
+    ASSERT_FALSE(Json::parse("tru").has_value());
+    ASSERT_FALSE(Json::parse("1 2").has_value());
+}
+
+// === Language Server Tests ===
+
+TEST(lsp_initialize_and_shutdown) {
+    LanguageServer server;
+    auto response = single_message(server.handle(R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{}})"));
+    ASSERT_EQ(response.get("id")->as_number(), 1.0);
+    ASSERT_TRUE(response.get_path({"result", "capabilities", "definitionProvider"})->as_bool());
+    
+    auto shutdown = single_message(server.handle(R"({"jsonrpc":"2.0","id":2,"method":"shutdown"})"));
+    ASSERT_TRUE(shutdown.get("result")->is_null());
+    auto exit = server.handle(R"({"jsonrpc":"2.0","method":"exit"})");
+    ASSERT_TRUE(exit.empty());
+    ASSERT_TRUE(server.should_exit());
+    ASSERT_EQ(server.exit_code(), 0);
+}
+
+TEST(lsp_diagnostics) {
+    LanguageServer server;
+    auto clean = single_message(server.handle(did_open("file:///a.dt", "package main; fn main() i32 { return 1; }")));
+    ASSERT_EQ(clean.get("method")->as_string(), "textDocument/publishDiagnostics");
+    ASSERT_TRUE(clean.get_path({"params", "diagnostics"})->as_array().empty());
+    
+    // Malformed expressions must produce diagnostics, not crash the server
+    auto broken = single_message(server.handle(did_open("file:///b.dt", "package main;\nfn main() i32 { return 1 + ; }")));
+    const auto& diagnostics = broken.get_path({"params", "diagnostics"})->as_array();
+    ASSERT_FALSE(diagnostics.empty());
+    ASSERT_EQ(diagnostics[0].get("message")->as_string(), "Expected expression");
+    ASSERT_EQ(diagnostics[0].get_path({"range", "start", "line"})->as_number(), 1.0);
+    
+    auto lexer_error = single_message(server.handle(did_open("file:///c.dt", "package main; @")));
+    ASSERT_EQ(lexer_error.get_path({"params", "diagnostics"})->as_array()[0].get("source")->as_string(), "dacite-lexer");
+}
+
+TEST(lsp_definition_across_files) {
+    LanguageServer server;
+    server.handle(did_open("file:///a.dt", "package main;\nfn helper() i32 { return 1; }"));
+    server.handle(did_open("file:///b.dt", "package main;\nfn main() i32 { return 2; }"));
+    
+    auto response = single_message(server.handle(definition(7, "file:///a.dt", 1, 5)));
+    const auto& locations = response.get("result")->as_array();
+    ASSERT_EQ(locations.size(), 1);
+    ASSERT_EQ(locations[0].get("uri")->as_string(), "file:///a.dt");
+    ASSERT_EQ(locations[0].get_path({"range", "start", "character"})->as_number(), 3.0);
+    
+    // Not on an identifier
+    auto nothing = single_message(server.handle(definition(8, "file:///a.dt", 1, 0)));
+    ASSERT_TRUE(nothing.get("result")->is_null());
+    
+    ASSERT_NOT_NULL(server.find_symbol("main"));
+}
+
+TEST(lsp_definition_rejects_invalid_positions) {
+    LanguageServer server;
+    server.handle(did_open("file:///a.dt", "package main;\nfn helper() i32 { return 1; }"));
+    for (std::string position : {R"({"line":-1,"character":5})", R"({"line":1,"character":1.5})",
+                                 R"({"line":1e300,"character":5})", R"({"line":1,"character":"5"})",
+                                 R"({"line":1})"}) {
+        auto response = single_message(server.handle(
+            R"({"jsonrpc":"2.0","id":1,"method":"textDocument/definition","params":{"textDocument":{"uri":"file:///a.dt"},"position":)" +
+            position + "}}"));
+        ASSERT_EQ(response.get_path({"error", "code"})->as_number(), -32602.0);
+    }
+    
+    // Lines past the end of the document are valid and find nothing
+    auto past_end = single_message(server.handle(definition(2, "file:///a.dt", 40, 0)));
+    ASSERT_TRUE(past_end.get("result")->is_null());
+}
+
+TEST(lsp_position_encodings) {
+    // The emoji is one code point but two UTF-16 units
+    std::string source = "package main; fn main() i32 { print(\"\xF0\x9F\x98\x80\"); return f(); } fn f() i32 { return 1; }";
+    
+    LanguageServer utf16;
+    auto initialized = single_message(utf16.handle(R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{}})"));
+    ASSERT_EQ(initialized.get_path({"result", "capabilities", "positionEncoding"})->as_string(), "utf-16");
+    utf16.handle(did_open("file:///a.dt", source));
+    auto response = single_message(utf16.handle(definition(2, "file:///a.dt", 0, 50)));
+    const auto& locations = response.get("result")->as_array();
+    ASSERT_EQ(locations.size(), 1);
+    ASSERT_EQ(locations[0].get_path({"range", "start", "character"})->as_number(), 60.0);
+    
+    LanguageServer utf32;
+    initialized = single_message(utf32.handle(
+        R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{"capabilities":{"general":{"positionEncodings":["utf-16","utf-32"]}}}})"));
+    ASSERT_EQ(initialized.get_path({"result", "capabilities", "positionEncoding"})->as_string(), "utf-32");
+    utf32.handle(did_open("file:///a.dt", source));
+    response = single_message(utf32.handle(definition(2, "file:///a.dt", 0, 49)));
+    const auto& code_point_locations = response.get("result")->as_array();
+    ASSERT_EQ(code_point_locations.size(), 1);
+    ASSERT_EQ(code_point_locations[0].get_path({"range", "start", "character"})->as_number(), 59.0);
+}
+
+TEST(lsp_index_follows_edits) {
+    LanguageServer server;
+    server.handle(did_open("file:///a.dt", "package main; fn first() i32 { return 1; }"));
+    ASSERT_NOT_NULL(server.find_symbol("first"));
+    
+    server.handle(R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///a.dt","version":2},"contentChanges":[{"text":"package main; fn second() i32 { return 2; }"}]}})");
+    ASSERT_TRUE(server.find_symbol("first") == nullptr);
+    ASSERT_NOT_NULL(server.find_symbol("second"));
+    
+    server.handle(R"({"jsonrpc":"2.0","method":"textDocument/didClose","params":{"textDocument":{"uri":"file:///a.dt"}}})");
+    ASSERT_TRUE(server.find_symbol("second") == nullptr);
+    ASSERT_EQ(server.get_document_count(), 0);
+}
+
+TEST(lsp_errors) {
+    LanguageServer server;
+    auto invalid = single_message(server.handle("not json"));
+    ASSERT_EQ(invalid.get_path({"error", "code"})->as_number(), -32700.0);
+    
+    auto unknown = single_message(server.handle(R"({"jsonrpc":"2.0","id":"x","method":"workspace/unknown"})"));
+    ASSERT_EQ(unknown.get("id")->as_string(), "x");
+    ASSERT_EQ(unknown.get_path({"error", "code"})->as_number(), -32601.0);
+}
+
+int main() {
+    std::cout << "Running Language Server Tests..." << std::endl;
+    
+    // JSON tests
+    RUN_TEST(json_round_trip);
+    RUN_TEST(json_unicode_escapes);
+    RUN_TEST(json_malformed);
+    
+    // Language server tests
+    RUN_TEST(lsp_initialize_and_shutdown);
+    RUN_TEST(lsp_diagnostics);
+    RUN_TEST(lsp_definition_across_files);
+    RUN_TEST(lsp_definition_rejects_invalid_positions);
+    RUN_TEST(lsp_position_encodings);
+    RUN_TEST(lsp_index_follows_edits);
+    RUN_TEST(lsp_errors);
+    
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
\ No newline at end of file
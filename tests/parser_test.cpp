@@ -1,5 +1,7 @@
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <string>
 #include "../src/parser.h"
@@ -85,6 +87,32 @@ TEST(return_statement_with_integer) {
     auto* int_literal = dynamic_cast<IntegerLiteral*>(return_stmt->expression.get());
     ASSERT_NOT_NULL(int_literal);
     ASSERT_EQ(int_literal->value, "42");
+    ASSERT_EQ(int_literal->number, 42u);
+}
+
+TEST(literals_carry_decoded_values) {
+    std::string source = "fn test() i32 { return 0x2A + 2.5; }";
+    auto tokens = tokenize(source);
+    
+    ParserConfig config;
+    Parser parser(std::move(tokens), config);
+    auto program = parser.parse();
+    
+    ASSERT_FALSE(parser.has_errors());
+    auto* func_decl = dynamic_cast<FunctionDeclaration*>(program->declarations[0].get());
+    auto* return_stmt = dynamic_cast<ReturnStatement*>(func_decl->body->statements[0].get());
+    auto* binary_expr = dynamic_cast<BinaryExpression*>(return_stmt->expression.get());
+    ASSERT_NOT_NULL(binary_expr);
+    
+    auto* int_literal = dynamic_cast<const IntegerLiteral*>(binary_expr->left.get());
+    ASSERT_NOT_NULL(int_literal);
+    ASSERT_EQ(int_literal->value, "0x2A");
+    ASSERT_EQ(int_literal->number, 42u);
+    
+    auto* float_literal = dynamic_cast<const FloatLiteral*>(binary_expr->right.get());
+    ASSERT_NOT_NULL(float_literal);
+    ASSERT_EQ(float_literal->number, 2.5);
+    ASSERT_EQ(float_literal->to_string(), "FloatLiteral(2.5)");
 }
 
 TEST(complete_program) {
@@ -309,12 +337,160 @@ TEST(equality_expressions) {
     ASSERT_EQ(binary_expr->operator_, BinaryOperator::EQUAL);
 }
 
+TEST(call_expression_statements) {
+    std::string source = "package main; fn main() i32 { print(\"hi\"); print(read_line()); 1; return 0; }";
+    Parser parser(tokenize(source));
+    auto program = parser.parse();
+    
+    // A bare literal has no effect and is still not a statement
+    ASSERT_EQ(parser.get_errors().size(), 1);
+    ASSERT_EQ(parser.get_errors()[0].message, "Expected statement");
+    
+    auto* func_decl = dynamic_cast<const FunctionDeclaration*>(program->declarations[0].get());
+    ASSERT_EQ(func_decl->body->statements.size(), 4);
+    auto* statement = dynamic_cast<const ExpressionStatement*>(func_decl->body->statements[0].get());
+    ASSERT_NOT_NULL(statement);
+    auto* call = dynamic_cast<const CallExpression*>(statement->expression.get());
+    ASSERT_NOT_NULL(call);
+    ASSERT_EQ(call->callee, "print");
+    ASSERT_EQ(call->arguments.size(), 1);
+    ASSERT_EQ(call->arguments[0]->type, ASTNodeType::STRING_LITERAL);
+    
+    auto* nested = dynamic_cast<const ExpressionStatement*>(func_decl->body->statements[1].get());
+    auto* inner = dynamic_cast<const CallExpression*>(
+        static_cast<const CallExpression&>(*nested->expression).arguments[0].get());
+    ASSERT_NOT_NULL(inner);
+    ASSERT_EQ(inner->callee, "read_line");
+    ASSERT_TRUE(inner->arguments.empty());
+}
+
+TEST(error_recovery_continues_parsing) {
+    std::string source =
+        "package main;\n"
+        "42 garbage ;\n"
+        "fn a() i32 { return 1 + ; }\n"
+        "x y\n"
+        "fn b() i32 { foo bar; return 2; }\n";
+    Parser parser(tokenize(source));
+    auto program = parser.parse();
+    
+    // One error per broken region, not one per token
+    ASSERT_EQ(parser.get_errors().size(), 4);
+    ASSERT_EQ(parser.get_errors()[0].message, "Expected function declaration");
+    ASSERT_EQ(parser.get_errors()[1].message, "Expected expression");
+    ASSERT_EQ(parser.get_errors()[3].message, "Expected statement");
+    ASSERT_EQ(program->declarations.size(), 2);
+    
+    // Broken pieces are kept as error nodes
+    auto* a = dynamic_cast<const FunctionDeclaration*>(program->declarations[0].get());
+    auto* a_return = dynamic_cast<const ReturnStatement*>(a->body->statements[0].get());
+    auto* sum = dynamic_cast<const BinaryExpression*>(a_return->expression.get());
+    ASSERT_NOT_NULL(sum);
+    ASSERT_EQ(sum->right->type, ASTNodeType::ERROR_EXPRESSION);
+    
+    auto* b = dynamic_cast<const FunctionDeclaration*>(program->declarations[1].get());
+    ASSERT_EQ(b->function_name, "b");
+    ASSERT_EQ(b->body->statements.size(), 2);
+    ASSERT_EQ(b->body->statements[0]->type, ASTNodeType::ERROR_STATEMENT);
+    ASSERT_EQ(b->body->statements[1]->type, ASTNodeType::RETURN_STATEMENT);
+}
+
+TEST(error_recovery_missing_brace) {
+    Parser parser(tokenize("fn a() i32 { return 1; fn b() i32 { return 2; }"));
+    auto program = parser.parse();
+    
+    ASSERT_EQ(parser.get_errors().size(), 1);
+    ASSERT_EQ(parser.get_errors()[0].message, "Expected '}' after block");
+    ASSERT_EQ(program->declarations.size(), 2);
+}
+
+TEST(error_cap) {
+    std::string source = "fn main() i32 {";
+    for (int i = 0; i < 1000; ++i) {
+        source += " 1; ";
+    }
+    source += "}";
+    
+    ParserConfig config;
+    config.max_errors = 10;
+    Parser parser(tokenize(source), config);
+    parser.parse();
+    ASSERT_EQ(parser.get_errors().size(), 11);
+    ASSERT_EQ(parser.get_errors().back().message, "Too many errors, stopping");
+    
+    ParserConfig no_recovery;
+    no_recovery.recover_from_errors = false;
+    Parser first_error_only(tokenize(source), no_recovery);
+    first_error_only.parse();
+    ASSERT_EQ(first_error_only.get_errors().size(), 1);
+}
+
+TEST(corrupted_input_parses_in_linear_time) {
+    auto make_source = [](size_t statements) {
+        std::string source = "package main; fn main() i32 {\n";
+        for (size_t i = 0; i < statements; ++i) {
+            source += i % 2 ? "return 1 + 2 * 3;\n" : "return 1 + + ; ) 4 5;\n";
+        }
+        return source + "}\n";
+    };
+    auto best_parse_ms = [](const std::vector<Token>& tokens) {
+        double best = 1e9;
+        for (int run = 0; run < 3; ++run) {
+            ParserConfig config;
+            config.max_errors = 0;
+            Parser parser(tokens, config);
+            auto start = std::chrono::steady_clock::now();
+            parser.parse();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+    
+    auto small = tokenize(make_source(5000));
+    auto large = tokenize(make_source(20000));
+    
+    ParserConfig config;
+    config.max_errors = 0;
+    Parser parser(large, config);
+    parser.parse();
+    ASSERT_EQ(parser.get_errors().size(), 10000);
+    
+    // 4x the input must not cost anywhere near 16x the time
+    ASSERT_TRUE(best_parse_ms(large) < 10.0 * best_parse_ms(small) + 5.0);
+}
+
+TEST(token_buffer_input) {
+    std::string source = "package main; fn main() i32 { return 1 + 2 * 3 == 7; }";
+    Parser from_tokens(tokenize(source));
+    auto expected = from_tokens.parse();
+    
+    TokenBuffer buffer;
+    Lexer(source).tokenize_all(buffer);
+    Parser from_buffer(std::move(buffer));
+    auto program = from_buffer.parse();
+    ASSERT_FALSE(from_buffer.has_errors());
+    ASSERT_EQ(program->to_string(), expected->to_string());
+    
+    auto* func_decl = dynamic_cast<const FunctionDeclaration*>(program->declarations[0].get());
+    ASSERT_EQ(func_decl->name_span.start.column, 18);
+    ASSERT_EQ(func_decl->span.end.offset, source.size());
+    
+    // Reset hands the previous buffer back for reuse
+    TokenBuffer next;
+    Lexer("fn f() i32 { return 2; }").tokenize_all(next);
+    from_buffer.reset(next);
+    ASSERT_TRUE(next.empty());
+    auto reparsed = from_buffer.parse();
+    ASSERT_EQ(reparsed->declarations.size(), 1);
+}
+
 int main() {
     std::cout << "Running Parser Tests..." << std::endl;
     
     RUN_TEST(basic_package_declaration);
     RUN_TEST(basic_function_declaration);
     RUN_TEST(return_statement_with_integer);
+    RUN_TEST(literals_carry_decoded_values);
     RUN_TEST(complete_program);
     RUN_TEST(ast_to_string);
     RUN_TEST(parser_error_handling);
@@ -325,6 +501,15 @@ int main() {
     RUN_TEST(comparison_expression);
     RUN_TEST(complex_precedence);
     RUN_TEST(equality_expressions);
+    RUN_TEST(call_expression_statements);
+    
+    RUN_TEST(token_buffer_input);
+    
+    // Error recovery tests
+    RUN_TEST(error_recovery_continues_parsing);
+    RUN_TEST(error_recovery_missing_brace);
+    RUN_TEST(error_cap);
+    RUN_TEST(corrupted_input_parses_in_linear_time);
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
@@ -1,12 +1,32 @@
 #include <iostream>
 #include <cassert>
 #include <string>
+#include <fstream>
+#include <cstdio>
+#include <limits>
+#include <array>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+#include <span>
 #include "../src/value.h"
 #include "../src/chunk.h"
 #include "../src/vm.h"
 #include "../src/compiler.h"
+#include "../src/profile.h"
+#include "../src/perf_map.h"
+#include "../src/metrics.h"
+#include "../src/repl.h"
 #include "../src/parser.h"
 #include "../src/lexer.h"
+#include "../src/alloc_tracker.h"
+#include "../src/pipeline_pool.h"
+#include "../src/snippet.h"
+#include "../src/chunk_builder.h"
+#include "../src/column.h"
+#include "../src/stream_io.h"
+#include "../src/string_kernels.h"
+#include <unistd.h>
 
 // Simple test framework (consistent with existing tests)
 #define TEST(name) void test_##name()
@@ -488,6 +508,57 @@ TEST(vm_division_by_zero) {
     ASSERT_EQ(result, VMResult::RUNTIME_ERROR);
 }
 
+TEST(vm_operators_replace_operands_in_place) {
+    VM vm;
+    Chunk chunk;
+    
+    // 1 2 3 4 + * -> 1 14, then == against 1 -> false
+    for (int value : {1, 2, 3, 4}) {
+        chunk.write_opcode(OpCode::OP_CONSTANT);
+        chunk.write_byte(static_cast<uint8_t>(chunk.add_constant(Value(value))));
+    }
+    chunk.write_opcode(OpCode::OP_ADD);
+    chunk.write_opcode(OpCode::OP_MULTIPLY);
+    VMResult result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.get_stack_size(), 2);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), 14);
+    
+    // peek_stack_top borrows the slot instead of copying it
+    const Value& top = vm.peek_stack_top();
+    ASSERT_EQ(&top, &vm.peek_stack_top());
+    
+    vm.reset();
+    chunk.write_opcode(OpCode::OP_EQUAL);
+    chunk.write_opcode(OpCode::OP_RETURN);
+    result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.get_stack_size(), 1);
+    ASSERT_FALSE(vm.peek_stack_top().as_boolean());
+}
+
+TEST(vm_integer_overflow_wraps) {
+    VM vm;
+    Chunk chunk;
+    
+    // INT32_MIN / -1 overflows and wraps back to INT32_MIN
+    size_t const_idx1 = chunk.add_constant(Value(std::numeric_limits<int32_t>::min()));
+    size_t const_idx2 = chunk.add_constant(Value(-1));
+    
+    chunk.write_opcode(OpCode::OP_CONSTANT);
+    chunk.write_byte(static_cast<uint8_t>(const_idx1));
+    chunk.write_opcode(OpCode::OP_CONSTANT);
+    chunk.write_byte(static_cast<uint8_t>(const_idx2));
+    chunk.write_opcode(OpCode::OP_DIVIDE);
+    
+    VMResult result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), std::numeric_limits<int32_t>::min());
+    
+    ASSERT_EQ(wrapping_add(std::numeric_limits<int32_t>::max(), 1), std::numeric_limits<int32_t>::min());
+    ASSERT_EQ(wrapping_multiply(65536, 65536), 0);
+}
+
 TEST(end_to_end_arithmetic_expression) {
     std::string source = "package main; fn main() i32 { return 2 + 3 * 4; }";
     auto program = parse_source(source);
@@ -528,6 +599,1112 @@ TEST(end_to_end_comparison_expression) {
     ASSERT_TRUE(result_value.as_boolean()); // 5 > 3 is true
 }
 
+// === Profile Tests ===
+
+TEST(profile_collection) {
+    std::string source = "package main; fn main() i32 { return 2 * 3 + 4; }";
+    auto program = parse_source(source);
+    ASSERT_NOT_NULL(program);
+    
+    Compiler compiler;
+    Chunk chunk;
+    CompileResult compile_result = compiler.compile(*program, chunk);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    
+    Profile profile;
+    VMConfig vm_config;
+    vm_config.profile = &profile;
+    VM vm(vm_config);
+    VMResult vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    
+    ASSERT_EQ(profile.runs, 1);
+    ASSERT_EQ(profile.count(OpCode::OP_CONSTANT), 3);
+    ASSERT_EQ(profile.count(OpCode::OP_MULTIPLY), 1);
+    ASSERT_EQ(profile.count(OpCode::OP_ADD), 1);
+    ASSERT_TRUE(profile.is_integer_only(OpCode::OP_ADD));
+    ASSERT_FALSE(profile.is_integer_only(OpCode::OP_DIVIDE));
+}
+
+TEST(profile_round_trip) {
+    Profile profile;
+    profile.runs = 3;
+    profile.record_opcode(OpCode::OP_ADD);
+    profile.record_operand(OpCode::OP_ADD, ValueType::INTEGER);
+    profile.record_opcode(OpCode::OP_EQUAL);
+    profile.record_operand(OpCode::OP_EQUAL, ValueType::BOOLEAN);
+    
+    auto parsed = Profile::parse(profile.to_string());
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->runs, 3);
+    ASSERT_EQ(parsed->count(OpCode::OP_ADD), 1);
+    ASSERT_TRUE(parsed->is_integer_only(OpCode::OP_ADD));
+    ASSERT_FALSE(parsed->is_integer_only(OpCode::OP_EQUAL));
+    
+    ASSERT_FALSE(Profile::parse("not a profile").has_value());
+}
+
+TEST(compiler_profile_guided_superinstructions) {
+    std::string source = "package main; fn main() i32 { return 2 * 3 + 4; }";
+    auto program = parse_source(source);
+    ASSERT_NOT_NULL(program);
+    
+    // First stage: plain compile and profiling run
+    Compiler compiler;
+    Chunk chunk;
+    CompileResult compile_result = compiler.compile(*program, chunk);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    
+    Profile profile;
+    VMConfig vm_config;
+    vm_config.profile = &profile;
+    VM profiling_vm(vm_config);
+    VMResult vm_result = profiling_vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    
+    // Second stage: recompile with the profile
+    CompilerConfig config;
+    config.profile = &profile;
+    Compiler optimizing_compiler(config);
+    Chunk optimized;
+    compile_result = optimizing_compiler.compile(*program, optimized);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    ASSERT_TRUE(optimized.size() < chunk.size());
+    ASSERT_EQ(optimized.get_code()[2], static_cast<uint8_t>(OpCode::OP_MULTIPLY_CONSTANT));
+    ASSERT_EQ(optimized.get_code()[4], static_cast<uint8_t>(OpCode::OP_ADD_CONSTANT));
+    
+    VM vm;
+    vm_result = vm.run(optimized);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), 10);
+    
+    // Re-profiling the fused build only records fused opcodes; the selection must not flip back
+    Profile fused_profile;
+    VMConfig fused_config;
+    fused_config.profile = &fused_profile;
+    VM fused_vm(fused_config);
+    vm_result = fused_vm.run(optimized);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(fused_profile.count(OpCode::OP_ADD), 0u);
+    
+    CompilerConfig reprofiled_config;
+    reprofiled_config.profile = &fused_profile;
+    Compiler reprofiled_compiler(reprofiled_config);
+    Chunk reoptimized;
+    compile_result = reprofiled_compiler.compile(*program, reoptimized);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    ASSERT_EQ(reoptimized.get_code(), optimized.get_code());
+}
+
+// === Symbolization Tests ===
+
+TEST(chunk_line_table) {
+    Chunk chunk;
+    chunk.write_opcode(OpCode::OP_CONSTANT, 3);
+    chunk.write_byte(0, 3);
+    chunk.write_opcode(OpCode::OP_RETURN, 4);
+    
+    ASSERT_EQ(chunk.get_line(0), 3);
+    ASSERT_EQ(chunk.get_line(1), 3);
+    ASSERT_EQ(chunk.get_line(2), 4);
+    ASSERT_EQ(chunk.get_line(99), 0);
+}
+
+TEST(compiler_records_lines_and_name) {
+    std::string source = "package main;\nfn main() i32 {\n    return 1 +\n        2;\n}";
+    auto program = parse_source(source);
+    ASSERT_NOT_NULL(program);
+    
+    Compiler compiler;
+    Chunk chunk;
+    CompileResult result = compiler.compile(*program, chunk);
+    ASSERT_EQ(result, CompileResult::OK);
+    
+    ASSERT_EQ(chunk.get_name(), "main");
+    ASSERT_EQ(chunk.get_line(0), 3);                // OP_CONSTANT 1
+    ASSERT_EQ(chunk.get_line(2), 4);                // OP_CONSTANT 2
+    ASSERT_EQ(chunk.get_line(chunk.size() - 1), 3); // OP_RETURN
+}
+
+TEST(perf_map_writer) {
+    std::string path = "/tmp/dacite_perf_map_test.map";
+    std::remove(path.c_str());
+    
+    Chunk chunk;
+    chunk.set_name("main");
+    size_t idx = chunk.add_constant(Value(7));
+    chunk.write_opcode(OpCode::OP_CONSTANT, 1);
+    chunk.write_byte(static_cast<uint8_t>(idx), 1);
+    chunk.write_opcode(OpCode::OP_RETURN, 1);
+    
+    {
+        PerfMap perf_map(path);
+        ASSERT_TRUE(perf_map.is_open());
+        
+        VMConfig config;
+        config.perf_map = &perf_map;
+        config.perf_line_markers = true;
+        VM vm(config);
+        VMResult result = vm.run(chunk);
+        ASSERT_EQ(result, VMResult::OK);
+        ASSERT_EQ(vm.peek_stack_top().as_integer(), 7);
+        result = vm.run(chunk); // Thunk generated only once
+        ASSERT_EQ(result, VMResult::OK);
+        ASSERT_EQ(vm.peek_stack_top().as_integer(), 7);
+        
+        // Address ranges from elsewhere are written as given
+        static const char other_code[16] = {};
+        bool added = perf_map.add(other_code, sizeof(other_code), "host::other");
+        ASSERT_TRUE(added);
+    }
+    
+    std::ifstream file(path);
+    std::string line;
+#if defined(__x86_64__) && defined(__linux__)
+    // The thunk's native range is named, not the bytecode
+    bool read = static_cast<bool>(std::getline(file, line));
+    ASSERT_TRUE(read);
+    ASSERT_TRUE(line.ends_with(" 20 dacite::main"));
+#endif
+    bool read_other = static_cast<bool>(std::getline(file, line));
+    ASSERT_TRUE(read_other);
+    ASSERT_TRUE(line.ends_with(" 10 host::other"));
+    bool read_past_end = static_cast<bool>(std::getline(file, line));
+    ASSERT_FALSE(read_past_end);
+    std::remove(path.c_str());
+}
+
+TEST(perf_map_shared_across_threads) {
+    std::string path = "/tmp/dacite_perf_map_threads_test.map";
+    std::remove(path.c_str());
+    
+    // New thunks are generated while other threads are running earlier ones
+    std::vector<Chunk> chunks(8);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].set_name("f" + std::to_string(i));
+        size_t idx = chunks[i].add_constant(Value(static_cast<int32_t>(i)));
+        chunks[i].write_opcode(OpCode::OP_CONSTANT);
+        chunks[i].write_byte(static_cast<uint8_t>(idx));
+        chunks[i].write_opcode(OpCode::OP_RETURN);
+    }
+    {
+        PerfMap perf_map(path);
+        auto run_all = [&](size_t first) {
+            VMConfig config;
+            config.perf_map = &perf_map;
+            VM vm(config);
+            for (int round = 0; round < 100; ++round) {
+                for (size_t i = 0; i < chunks.size(); ++i) {
+                    const Chunk& chunk = chunks[(first + i) % chunks.size()];
+                    vm.reset();
+                    VMResult result = vm.run(chunk);
+                    assert(result == VMResult::OK);
+                    assert(vm.peek_stack_top().as_integer() == static_cast<int32_t>((first + i) % chunks.size()));
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t) {
+            threads.emplace_back(run_all, t * 2);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    
+#if defined(__x86_64__) && defined(__linux__)
+    // One thunk per function, however many threads asked for it
+    std::ifstream file(path);
+    std::string line;
+    size_t entries = 0;
+    while (std::getline(file, line)) {
+        entries++;
+    }
+    ASSERT_EQ(entries, chunks.size());
+#endif
+    std::remove(path.c_str());
+}
+
+// === Metrics Tests ===
+
+TEST(metrics_pipeline) {
+    Metrics metrics;
+    std::string source = "package main; fn main() i32 { return 1 + 2; }";
+    
+    LexerConfig lexer_config;
+    lexer_config.metrics = &metrics;
+    Lexer lexer(source, lexer_config);
+    auto tokens = lexer.tokenize_all();
+    
+    ParserConfig parser_config;
+    parser_config.metrics = &metrics;
+    Parser parser(std::move(tokens), parser_config);
+    auto program = parser.parse();
+    ASSERT_NOT_NULL(program);
+    
+    CompilerConfig compiler_config;
+    compiler_config.metrics = &metrics;
+    Compiler compiler(compiler_config);
+    Chunk chunk;
+    CompileResult compile_result = compiler.compile(*program, chunk);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    
+    VMConfig vm_config;
+    vm_config.metrics = &metrics;
+    VM vm(vm_config);
+    VMResult vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(vm.get_instructions_executed(), 4);
+    
+    // Without a metrics sink the dispatch loop does not count
+    VM plain;
+    vm_result = plain.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(plain.get_instructions_executed(), 0);
+    
+    auto stats = metrics.get_stats();
+    ASSERT_EQ(stats.vm_runs, 1);
+    ASSERT_EQ(stats.instructions_executed, 4);
+    ASSERT_EQ(stats.runtime_errors, 0);
+    ASSERT_EQ(stats.stage(Stage::LEX).count, 1);
+    ASSERT_EQ(stats.stage(Stage::PARSE).count, 1);
+    ASSERT_EQ(stats.stage(Stage::COMPILE).count, 1);
+    ASSERT_EQ(stats.stage(Stage::RUN).count, 1);
+}
+
+TEST(metrics_runtime_errors_and_export) {
+    Metrics metrics;
+    Chunk chunk;
+    chunk.write_opcode(OpCode::OP_RETURN);
+    
+    VMConfig config;
+    config.metrics = &metrics;
+    VM vm(config);
+    VMResult result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::RUNTIME_ERROR);
+    ASSERT_EQ(metrics.get_stats().runtime_errors, 1);
+    
+    metrics.record_stage(Stage::LEX, std::chrono::microseconds(3));
+    auto stats = metrics.get_stats();
+    ASSERT_EQ(stats.stage(Stage::LEX).buckets[2], 1); // <= 4us
+    
+    std::string prometheus = metrics.to_prometheus();
+    ASSERT_TRUE(prometheus.find("dacite_runtime_errors_total 1\n") != std::string::npos);
+    ASSERT_TRUE(prometheus.find("dacite_stage_duration_microseconds_bucket{stage=\"lex\",le=\"4\"} 1\n") != std::string::npos);
+    ASSERT_TRUE(prometheus.find("dacite_stage_duration_microseconds_count{stage=\"run\"} 1\n") != std::string::npos);
+    
+    std::string json = metrics.to_json();
+    ASSERT_TRUE(json.starts_with("{\"vm_runs\":1,\"instructions_executed\":1,\"runtime_errors\":1,"));
+}
+
+TEST(metrics_histogram_shards_sum_on_read) {
+    Metrics metrics;
+    constexpr int THREADS = 4;
+    constexpr int RECORDS = 1000;
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < RECORDS; ++i) {
+                    metrics.record_stage(Stage::PARSE, std::chrono::microseconds(100));
+                }
+            });
+        }
+    }
+    
+    auto stats = metrics.get_stats();
+    const StageStats& parse = stats.stage(Stage::PARSE);
+    ASSERT_EQ(parse.count, uint64_t{THREADS * RECORDS});
+    ASSERT_EQ(parse.total_ns, uint64_t{THREADS * RECORDS} * 100000);
+    ASSERT_EQ(parse.buckets[7], uint64_t{THREADS * RECORDS}); // <= 128us
+}
+
+// === REPL Tests ===
+
+TEST(repl_expressions) {
+    Repl repl;
+    
+    auto sum = repl.eval("1 + 2 * 3");
+    ASSERT_TRUE(sum.ok);
+    ASSERT_EQ(sum.output, "7");
+    
+    auto comparison = repl.eval("5 > 3;");
+    ASSERT_TRUE(comparison.ok);
+    ASSERT_EQ(comparison.output, "true");
+    
+    auto declaration = repl.eval("fn main() i32 { return 10 - 4; }");
+    ASSERT_TRUE(declaration.ok);
+    ASSERT_EQ(declaration.output, "6");
+    
+    ASSERT_EQ(repl.get_input_count(), 3);
+}
+
+TEST(repl_errors_keep_session_alive) {
+    Repl repl;
+    
+    auto runtime_error = repl.eval("1 / 0");
+    ASSERT_FALSE(runtime_error.ok);
+    ASSERT_EQ(runtime_error.output, "Runtime error: Division by zero");
+    
+    auto parse_error = repl.eval("1 2");
+    ASSERT_FALSE(parse_error.ok);
+    ASSERT_EQ(parse_error.output, "Error at line 1, column 3: Unexpected token after expression");
+    
+    auto lex_error = repl.eval("1 @ 2");
+    ASSERT_FALSE(lex_error.ok);
+    
+    auto recovered = repl.eval("2 + 2");
+    ASSERT_TRUE(recovered.ok);
+    ASSERT_EQ(recovered.output, "4");
+}
+
+TEST(repl_string_results) {
+    // Each input's string result stays on the VM stack until the next input replaces it
+    Repl repl;
+    
+    auto first = repl.eval("\"first\"");
+    ASSERT_TRUE(first.ok);
+    ASSERT_EQ(first.output, "first");
+    
+    auto second = repl.eval("split(\"a,second\", \",\", 1)");
+    ASSERT_TRUE(second.ok);
+    ASSERT_EQ(second.output, "second");
+    
+    auto third = repl.eval("\"third\" + \"!\"");
+    ASSERT_TRUE(third.ok);
+    ASSERT_EQ(third.output, "third!");
+}
+
+// === Allocation Tracking Tests ===
+
+TEST(allocation_scopes_are_per_thread) {
+    // A large allocation on another thread must not show up in this thread's scope
+    AllocationScope scope;
+    std::vector<char> small(64);
+    std::thread([] {
+        AllocationScope other;
+        std::vector<char> large(1 << 20);
+        ASSERT_TRUE(other.stats().peak_live_bytes >= large.size());
+    }).join();
+    
+    AllocationStats stats = scope.stats();
+    ASSERT_TRUE(stats.peak_live_bytes >= small.size());
+    ASSERT_TRUE(stats.peak_live_bytes < (1 << 20));
+    ASSERT_TRUE(stats.bytes < (1 << 20));
+}
+
+TEST(allocation_scope_nesting) {
+    ASSERT_TRUE(alloc_tracker::is_enabled());
+    
+    AllocationScope outer;
+    AllocationStats inner_stats;
+    {
+        AllocationScope inner;
+        Lexer lexer("package main; fn main() i32 { return 1 + 2; }");
+        auto tokens = lexer.tokenize_all();
+        inner_stats = inner.stats();
+        ASSERT_TRUE(inner_stats.allocations > 0);
+        ASSERT_TRUE(inner_stats.bytes >= tokens.capacity() * sizeof(Token));
+        ASSERT_TRUE(inner_stats.peak_live_bytes >= tokens.capacity() * sizeof(Token));
+    }
+    
+    // The inner scope's memory is freed, but the outer scope still sees its peak
+    auto outer_stats = outer.stats();
+    ASSERT_TRUE(outer_stats.allocations >= inner_stats.allocations);
+    ASSERT_TRUE(outer_stats.peak_live_bytes >= inner_stats.peak_live_bytes);
+}
+
+// === Memory Resource Tests ===
+
+/// Memory resource that counts the allocations it forwards to the global heap
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+TEST(memory_resource_containers) {
+    CountingResource resource;
+    
+    LexerConfig lexer_config;
+    lexer_config.memory_resource = &resource;
+    Lexer lexer("1 @ 2", lexer_config);
+    lexer.tokenize_all();
+    ASSERT_TRUE(lexer.has_errors());
+    size_t after_lexer = resource.allocations;
+    ASSERT_TRUE(after_lexer > 0);
+    
+    ParserConfig parser_config;
+    parser_config.memory_resource = &resource;
+    Parser parser(Lexer("package main; fn main() i32 { return 7; }").tokenize_all(), parser_config);
+    auto program = parser.parse();
+    ASSERT_FALSE(parser.has_errors());
+    size_t after_parser = resource.allocations;
+    ASSERT_TRUE(after_parser > after_lexer);
+    
+    Chunk chunk(&resource);
+    Compiler compiler;
+    CompileResult compile_result = compiler.compile(*program, chunk);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    size_t after_compiler = resource.allocations;
+    ASSERT_TRUE(after_compiler > after_parser);
+    
+    VMConfig vm_config;
+    vm_config.memory_resource = &resource;
+    VM vm(vm_config);
+    VMResult vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), 7);
+    ASSERT_TRUE(resource.allocations > after_compiler);
+}
+
+TEST(memory_resource_monotonic_request) {
+    // One buffer per request; the null upstream proves nothing spills to the heap
+    std::array<std::byte, 64 * 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    
+    LexerConfig lexer_config;
+    lexer_config.memory_resource = &arena;
+    ParserConfig parser_config;
+    parser_config.memory_resource = &arena;
+    VMConfig vm_config;
+    vm_config.memory_resource = &arena;
+    
+    Lexer lexer("package main; fn main() i32 { return 6 * 7; }", lexer_config);
+    Parser parser(lexer.tokenize_all(), parser_config);
+    auto program = parser.parse();
+    Chunk chunk(&arena);
+    Compiler compiler;
+    CompileResult compile_result = compiler.compile(*program, chunk);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    VM vm(vm_config);
+    VMResult vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), 42);
+}
+
+TEST(object_pool_reuse) {
+    VMPool vms(VMConfig{}, 2);
+    ASSERT_EQ(vms.available(), 2u);
+    {
+        auto first = vms.acquire();
+        auto second = vms.acquire();
+        auto third = vms.acquire();
+        ASSERT_EQ(vms.available(), 0u);
+        ASSERT_EQ(vms.created(), 3u);
+        
+        Chunk chunk;
+        chunk.write_opcode(OpCode::OP_CONSTANT);
+        chunk.write_byte(static_cast<uint8_t>(chunk.add_constant(Value(7))));
+        VMResult result = first->run(chunk);
+        ASSERT_EQ(result, VMResult::OK);
+        ASSERT_FALSE(first->is_stack_empty());
+    }
+    ASSERT_EQ(vms.available(), 3u);
+    
+    // Returned VMs come back reset
+    auto vm = vms.acquire();
+    ASSERT_TRUE(vm->is_stack_empty());
+    ASSERT_EQ(vms.created(), 3u);
+    
+    ChunkPool chunks(1);
+    {
+        auto chunk = chunks.acquire();
+        chunk->write_byte(42);
+    }
+    auto chunk = chunks.acquire();
+    ASSERT_TRUE(chunk->empty());
+    ASSERT_EQ(chunks.created(), 1u);
+}
+
+TEST(object_pool_steady_state_requests) {
+    VMPool vms;
+    ChunkPool chunks;
+    Lexer lexer("");
+    Parser parser(std::vector<Token>{});
+    Compiler compiler;
+    std::vector<Token> tokens;
+    uint64_t ast_allocations = 0;
+    
+    auto handle_request = [&](std::string_view source) {
+        lexer.reset(source);
+        lexer.tokenize_all(tokens);
+        parser.reset(tokens);
+        std::unique_ptr<Program> program;
+        {
+            AllocationScope scope;
+            program = parser.parse();
+            ast_allocations = scope.stats().allocations;
+        }
+        auto chunk = chunks.acquire();
+        CompileResult compile_result = compiler.compile(*program, *chunk);
+        ASSERT_EQ(compile_result, CompileResult::OK);
+        auto vm = vms.acquire();
+        VMResult vm_result = vm->run(*chunk);
+        ASSERT_EQ(vm_result, VMResult::OK);
+        return vm->peek_stack_top().as_integer();
+    };
+    
+    // The first request grows every buffer to its working size
+    int32_t first = handle_request("package main; fn main() i32 { return 1 + 2 * 3 - 4 / 2 + 5 * 6; }");
+    ASSERT_EQ(first, 35);
+    
+    // Later requests only allocate the AST the parser hands back
+    const char* requests[] = {
+        "package main; fn main() i32 { return 6 * 7; }",
+        "package main; fn main() i32 { return 9 - 3 + 1; }",
+        "package main; fn main() i32 { return 1 + 2 * 3 - 4 / 2 + 5 * 6; }",
+    };
+    for (const char* source : requests) {
+        AllocationScope scope;
+        handle_request(source);
+        ASSERT_EQ(scope.stats().allocations, ast_allocations);
+    }
+    ASSERT_EQ(vms.created(), 1u);
+    ASSERT_EQ(chunks.created(), 1u);
+}
+
+// === Snippet Tests ===
+
+// Compiled while building this test; a syntax error here would fail the build
+constexpr auto ANSWER_SNIPPET = compile_snippet<"6 * 7">();
+static_assert(ANSWER_SNIPPET.constants == std::array<int32_t, 2>{6, 7});
+static_assert(ANSWER_SNIPPET.code == std::array<uint8_t, 6>{
+    static_cast<uint8_t>(OpCode::OP_CONSTANT), 0,
+    static_cast<uint8_t>(OpCode::OP_CONSTANT), 1,
+    static_cast<uint8_t>(OpCode::OP_MULTIPLY),
+    static_cast<uint8_t>(OpCode::OP_RETURN)});
+
+constexpr auto COMPARISON_SNIPPET = compile_snippet<"1 + 2 * 3 // comment\n  >= 7;">();
+static_assert(COMPARISON_SNIPPET.code.size() == 12);
+static_assert(COMPARISON_SNIPPET.code[10] == static_cast<uint8_t>(OpCode::OP_GREATER_EQUAL));
+
+constexpr bool snippet_fails(std::string_view source, std::string_view message, size_t column) {
+    SnippetCompiler compiler(source);
+    return compiler.compile() == CompileResult::ERROR && compiler.error_message() == message &&
+           compiler.error_position().column == column;
+}
+static_assert(snippet_fails("1 +", "Expected expression", 4));
+static_assert(snippet_fails("1 2", "Unexpected token after expression", 3));
+static_assert(snippet_fails("1 @ 2", "Unsupported character in snippet", 3));
+static_assert(snippet_fails("2147483648", "Invalid integer literal", 1));
+
+TEST(snippet_matches_runtime_pipeline) {
+    constexpr auto snippet = compile_snippet<"10 - 4\n  / 2 < 9">();
+    
+    Lexer lexer("10 - 4\n  / 2 < 9");
+    Parser parser(lexer.tokenize_all());
+    auto expression = parser.parse_standalone_expression();
+    ASSERT_FALSE(parser.has_errors());
+    Chunk expected;
+    Compiler compiler;
+    CompileResult compile_result = compiler.compile_standalone_expression(*expression, expected);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    
+    Chunk chunk;
+    snippet.load(chunk);
+    ASSERT_EQ(chunk.size(), expected.size());
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        ASSERT_EQ(chunk.get_code()[i], expected.get_code()[i]);
+        ASSERT_EQ(chunk.get_line(i), expected.get_line(i));
+    }
+    ASSERT_EQ(chunk.get_constants().size(), expected.get_constants().size());
+    
+    VM vm;
+    VMResult vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top(), Value(true));
+    
+    ANSWER_SNIPPET.load(chunk);
+    vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), 42);
+}
+
+// === Chunk Builder Tests ===
+
+// Builder expressions fold in constant expressions
+static_assert((ChunkBuilder::lit(2) + ChunkBuilder::lit(3) * 4).fold().value == 14);
+static_assert((ChunkBuilder::lit(INT32_MAX) + 1).fold().value == INT32_MIN);
+static_assert(!(ChunkBuilder::lit(1) / 0).fold().constant);
+
+// Ill-typed expressions do not compile
+template <typename L, typename R>
+concept Addable = requires(L left, R right) { left + right; };
+template <typename L, typename R>
+concept Comparable = requires(L left, R right) { left == right; };
+static_assert(Addable<build::IntegerLiteral, int>);
+static_assert(!Addable<build::IntegerLiteral, int64_t>);   // Would wrap silently
+static_assert(!Addable<build::IntegerLiteral, uint32_t>);
+static_assert(!Addable<build::IntegerLiteral, char>);
+static_assert(!Addable<build::IntegerLiteral, build::BooleanLiteral>);
+static_assert(!Addable<decltype(ChunkBuilder::lit(1) < 2), int>);
+static_assert(Comparable<build::BooleanLiteral, decltype(ChunkBuilder::lit(1) < 2)>);
+static_assert(!Comparable<build::IntegerLiteral, build::BooleanLiteral>);
+
+TEST(chunk_builder_folds_constants) {
+    ChunkBuilder builder;
+    Chunk chunk;
+    
+    CompileResult compile_result = builder.fn("f", chunk, [](auto& b) { return b.lit(1) + b.lit(20) * 2 > 40; });
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    ASSERT_EQ(chunk.get_name(), "f");
+    ASSERT_EQ(chunk.size(), 3);
+    ASSERT_EQ(chunk.get_constant(0), Value(true));
+    
+    VM vm;
+    VMResult vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top(), Value(true));
+}
+
+TEST(chunk_builder_keeps_runtime_errors) {
+    ChunkBuilder builder;
+    Chunk chunk;
+    
+    // 1 / 0 cannot fold; the constant operands around it become superinstructions
+    CompileResult compile_result = builder.fn("g", chunk, [](auto& b) { return (b.lit(7) + b.lit(1) / 0) * 3 - 1; });
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    const auto& code = chunk.get_code();
+    ASSERT_EQ(code[6], static_cast<uint8_t>(OpCode::OP_DIVIDE));
+    ASSERT_EQ(code[7], static_cast<uint8_t>(OpCode::OP_ADD));
+    ASSERT_EQ(code[8], static_cast<uint8_t>(OpCode::OP_MULTIPLY_CONSTANT));
+    ASSERT_EQ(code[10], static_cast<uint8_t>(OpCode::OP_SUBTRACT_CONSTANT));
+    ASSERT_EQ(code[11], 1);  // Shares the constant 1 with the division
+    ASSERT_EQ(chunk.get_constants().size(), 4);
+    
+    VM vm;
+    VMResult vm_result = vm.run(chunk);
+    ASSERT_EQ(vm_result, VMResult::RUNTIME_ERROR);
+    ASSERT_EQ(vm.get_error_message(), "Division by zero");
+}
+
+TEST(chunk_builder_rejects_constant_overflow) {
+    ChunkBuilder builder;
+    Chunk chunk;
+    
+    // 1 / 0 keeps the sum from folding, so every addend needs its own constant
+    auto result = builder.fn("h", chunk, [](auto& b) {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return ((b.lit(1) / 0) + ... + static_cast<int32_t>(I + 2));
+        }(std::make_index_sequence<300>());
+    });
+    ASSERT_EQ(result, CompileResult::ERROR);
+    ASSERT_EQ(builder.get_error_message(), "Too many constants");
+    ASSERT_EQ(chunk.get_constants().size(), 256);  // The rejected constant is not left in the pool
+}
+
+// === Column Binding Tests ===
+
+// Emit `opcode slot` for a column instruction
+void write_column_op(Chunk& chunk, OpCode opcode, uint8_t slot) {
+    chunk.write_opcode(opcode);
+    chunk.write_byte(slot);
+}
+
+TEST(column_binding_reads_host_memory) {
+    std::vector<int32_t> integers = {5, -2, 40, INT32_MAX};
+    std::array<double, 6> doubles = {0.5, 1.25, 2.0, 4.0, 8.0, 16.0};
+    VM vm;
+    auto integer_column = vm.bind_column(std::span<const int32_t>(integers));
+    auto double_column = vm.bind_column(std::span<const double>(doubles));
+    ASSERT_EQ(integer_column.slot(), 0);
+    ASSERT_EQ(double_column.slot(), 1);
+    
+    Chunk chunk;
+    write_column_op(chunk, OpCode::OP_COLUMN_SUM, integer_column.slot());
+    chunk.write_opcode(OpCode::OP_RETURN);
+    VMResult result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), wrapping_add(43, INT32_MAX));
+    
+    // The VM sees host writes because nothing was copied
+    integers[3] = 1;
+    vm.reset();
+    result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), 44);
+    
+    chunk.clear();
+    write_column_op(chunk, OpCode::OP_COLUMN_SUM, double_column.slot());
+    write_column_op(chunk, OpCode::OP_COLUMN_LENGTH, double_column.slot());
+    chunk.add_constant(Value(1));
+    chunk.write_opcode(OpCode::OP_SUBTRACT_CONSTANT);
+    chunk.write_byte(0);
+    write_column_op(chunk, OpCode::OP_COLUMN_GET, double_column.slot());
+    chunk.write_opcode(OpCode::OP_RETURN);
+    vm.reset();
+    result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.stack_to_string(), "[31.75, 16]");
+    ASSERT_EQ(vm.peek_stack_top(), Value(16.0));
+}
+
+TEST(column_binding_scope) {
+    std::vector<int32_t> values = {1, 2, 3};
+    VM vm;
+    Chunk chunk;
+    chunk.add_constant(Value(3));
+    chunk.write_opcode(OpCode::OP_CONSTANT);
+    chunk.write_byte(0);
+    write_column_op(chunk, OpCode::OP_COLUMN_GET, 0);
+    chunk.write_opcode(OpCode::OP_RETURN);
+    
+    VMResult result;
+    {
+        auto binding = vm.bind_column(std::span<const int32_t>(values));
+        ASSERT_TRUE(binding);
+        result = vm.run(chunk);
+        ASSERT_EQ(result, VMResult::RUNTIME_ERROR);
+        ASSERT_EQ(vm.get_error_message(), "Column index out of range");
+    }
+    
+    // Once the binding is gone the slot reads as unbound, then is reused
+    vm.reset();
+    result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::RUNTIME_ERROR);
+    ASSERT_EQ(vm.get_error_message(), "Column 0 is not bound");
+    
+    values.push_back(4);
+    auto rebound = vm.bind_column(std::span<const int32_t>(values));
+    ASSERT_EQ(rebound.slot(), 0);
+    vm.reset();
+    result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_integer(), 4);
+}
+
+std::string read_file(FILE* file) {
+    std::fflush(file);
+    std::rewind(file);
+    std::string text;
+    char buffer[256];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, count);
+    }
+    return text;
+}
+
+TEST(string_values) {
+    Value owned(StringRef::make("text"));
+    Value copy = owned;
+    ASSERT_TRUE(copy.is_string());
+    ASSERT_EQ(copy.as_string(), "text");
+    ASSERT_EQ(copy, Value(StringRef::make("text")));
+    ASSERT_FALSE(copy == Value(StringRef::make("other")));
+    ASSERT_EQ(owned.to_string(), "text");
+    
+    // Constants are owned by the chunk, and copies of them are not counted
+    Chunk chunk;
+    size_t index = chunk.add_string_constant("constant");
+    Value constant = chunk.get_constant(index);
+    const StringObject* object = constant.as_string_ref().get();
+    ASSERT_TRUE(object->is_static());
+    ASSERT_EQ(object->ref_count(), 1);
+    ASSERT_EQ(constant.as_string(), "constant");
+    
+    // Slices borrow their constant too
+    StringRef slice(StringObject::make_slice(constant.as_string_ref().get(), "const"));
+    ASSERT_TRUE(slice.get()->borrows_static());
+    ASSERT_FALSE(owned.as_string_ref().get()->borrows_static());
+}
+
+TEST(shared_chunk_runs_on_several_threads) {
+    // Constants are never counted, so threads share the chunk without touching them
+    Parser parser(Lexer("package main; fn main() i32 { return split(\"a b c\" + \" d\", \" \", 3); }").tokenize_all());
+    auto program = parser.parse();
+    Chunk chunk;
+    Compiler compiler;
+    CompileResult compile_result = compiler.compile(*program, chunk);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    
+    auto run_many = [&chunk] {
+        VM vm;
+        for (int i = 0; i < 1000; ++i) {
+            vm.reset();
+            VMResult result = vm.run(chunk);
+            assert(result == VMResult::OK);
+            assert(vm.peek_stack_top().as_string() == "d");
+        }
+    };
+    std::thread other(run_many);
+    run_many();
+    other.join();
+    Value constant = chunk.get_constant(0);
+    ASSERT_EQ(constant.as_string_ref().get()->ref_count(), 1);
+}
+
+TEST(string_results_outlive_chunk_and_vm) {
+    // As the CLI does, keep only the result of running a program
+    auto run = [](const std::string& expression) {
+        Parser parser(Lexer("package main; fn main() i32 { return " + expression + "; }").tokenize_all());
+        auto program = parser.parse();
+        Chunk chunk;
+        Compiler compiler;
+        CompileResult compile_result = compiler.compile(*program, chunk);
+        assert(compile_result == CompileResult::OK);
+        VM vm;
+        VMResult result = vm.run(chunk);
+        assert(result == VMResult::OK);
+        return vm.peek_stack_top();
+    };
+    Value literal = run("\"literal\"");
+    ASSERT_EQ(literal.to_string(), "literal");
+    
+    // A field split from a constant keeps the constant alive through the slice
+    Value field = run("split(\"GET /a 200\", \" \", 1)");
+    ASSERT_EQ(field.to_string(), "/a");
+    ASSERT_EQ(field.as_string(), "/a");
+}
+
+TEST(string_concatenation_appends_in_place) {
+    StringRef text = StringRef::make("ab");
+    const StringObject* object = text.get();
+    text.append("cd");
+    ASSERT_EQ(text.get(), object);
+    ASSERT_EQ(text.view(), "abcd");
+    
+    // A shared string is copied, leaving the other reference unchanged
+    StringRef shared = text;
+    text.append("ef");
+    ASSERT_FALSE(text.get() == object);
+    ASSERT_EQ(text.view(), "abcdef");
+    ASSERT_EQ(shared.view(), "abcd");
+    ASSERT_EQ(text.get()->ref_count(), 1);
+    
+    // Constants are never modified, however many times they are concatenated onto
+    Chunk chunk;
+    size_t left = chunk.add_string_constant("x");
+    size_t right = chunk.add_string_constant("y");
+    for (int i = 0; i < 3; ++i) {
+        chunk.write_opcode(OpCode::OP_CONSTANT);
+        chunk.write_byte(static_cast<uint8_t>(i == 0 ? left : right));
+        if (i > 0) chunk.write_opcode(OpCode::OP_ADD);
+    }
+    chunk.write_opcode(OpCode::OP_RETURN);
+    VM vm;
+    VMResult result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top().as_string(), "xyy");
+    ASSERT_EQ(chunk.get_constant(left).as_string(), "x");
+    
+    // Mixed operands are still an error
+    chunk.clear();
+    chunk.add_string_constant("x");
+    chunk.add_constant(Value(1));
+    chunk.write_opcode(OpCode::OP_CONSTANT);
+    chunk.write_byte(0);
+    chunk.write_opcode(OpCode::OP_CONSTANT);
+    chunk.write_byte(1);
+    chunk.write_opcode(OpCode::OP_ADD);
+    vm.reset();
+    result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::RUNTIME_ERROR);
+    ASSERT_EQ(vm.get_error_message(), "Addition requires two integers or two strings");
+}
+
+TEST(print_and_read_line_builtins) {
+    const char* input_path = "/tmp/dacite_read_line_test.txt";
+    {
+        std::ofstream input(input_path, std::ios::binary);
+        input << "first\r\nsecond";
+    }
+    auto reader = LineReader::open(input_path);
+    ASSERT_NOT_NULL(reader.get());
+    ASSERT_TRUE(reader->is_mapped());
+    
+    FILE* output_file = std::tmpfile();
+    OutputBuffer output(fileno(output_file));
+    VMConfig config;
+    config.output = &output;
+    config.input = reader.get();
+    
+    Parser parser(Lexer(
+        "package main; fn main() i32 {"
+        " print(\"hello\\tworld\"); print(6 * 7);"
+        " print(read_line()); print(read_line()); print(read_line());"
+        " return read_line() == read_line(); }").tokenize_all());
+    auto program = parser.parse();
+    ASSERT_FALSE(parser.has_errors());
+    Chunk chunk;
+    Compiler compiler;
+    CompileResult compile_result = compiler.compile(*program, chunk);
+    ASSERT_EQ(compile_result, CompileResult::OK);
+    
+    VM vm(config);
+    VMResult result = vm.run(chunk);
+    ASSERT_EQ(result, VMResult::OK);
+    ASSERT_EQ(vm.peek_stack_top(), Value(true));
+    
+    // Every line stays in the buffer until the host flushes
+    ASSERT_EQ(output.system_calls(), 0);
+    bool flushed = output.flush();
+    ASSERT_TRUE(flushed);
+    ASSERT_EQ(output.system_calls(), 1);
+    std::string printed = read_file(output_file);
+    ASSERT_EQ(printed, "hello\tworld\n42\nfirst\nsecond\nnil\n");
+    std::fclose(output_file);
+    std::remove(input_path);
+    
+    // Unknown functions and wrong arities are compile errors
+    Parser unknown(Lexer("package main; fn main() i32 { println(1); return 0; }").tokenize_all());
+    chunk.clear();
+    compile_result = compiler.compile(*unknown.parse(), chunk);
+    ASSERT_EQ(compile_result, CompileResult::ERROR);
+    ASSERT_EQ(compiler.get_error_message(), "Unknown function: println");
+    Parser arity(Lexer("package main; fn main() i32 { print(); return 0; }").tokenize_all());
+    chunk.clear();
+    compile_result = compiler.compile(*arity.parse(), chunk);
+    ASSERT_EQ(compile_result, CompileResult::ERROR);
+    ASSERT_EQ(compiler.get_error_message(), "print expects 1 argument(s) but got 0");
+}
+
+TEST(output_buffer_batches_writes) {
+    FILE* file = std::tmpfile();
+    OutputBuffer output(fileno(file), 16);
+    output.write("ab");
+    output.write_line("cd");
+    ASSERT_EQ(output.system_calls(), 0);
+    
+    // Filling the buffer flushes it once before taking more small writes
+    output.write("0123456789");
+    output.write("xyz");
+    ASSERT_EQ(output.system_calls(), 1);
+    
+    // A write larger than the buffer leaves together with the buffered bytes
+    std::string large(100, 'x');
+    output.write_line(large);
+    ASSERT_EQ(output.system_calls(), 2);
+    bool flushed = output.flush();
+    ASSERT_TRUE(flushed);
+    ASSERT_EQ(output.system_calls(), 2);
+    std::string written = read_file(file);
+    ASSERT_EQ(written, "abcd\n0123456789xyz" + large + "\n");
+    std::fclose(file);
+}
+
+TEST(line_reader_grows_for_long_lines) {
+    int fds[2];
+    int piped = pipe(fds);
+    ASSERT_EQ(piped, 0);
+    std::string long_line(10000, 'y');
+    std::string input = "a\n" + long_line + "\n\nlast\r\nno newline";
+    ssize_t written = write(fds[1], input.data(), input.size());
+    ASSERT_EQ(written, static_cast<ssize_t>(input.size()));
+    close(fds[1]);
+    
+    LineReader reader(fds[0], 8);
+    ASSERT_FALSE(reader.is_mapped());
+    std::vector<std::optional<std::string_view>> expected = {"a", long_line, "", "last", "no newline", std::nullopt, std::nullopt};
+    for (const auto& expected_line : expected) {
+        std::optional<std::string_view> line = reader.next_line();
+        ASSERT_EQ(line, expected_line);
+    }
+    close(fds[0]);
+}
+
+TEST(string_kernels_match_scalar_results) {
+    // Lengths around the 16-byte block size exercise both the vector loops and their tails
+    for (size_t length = 0; length < 70; ++length) {
+        std::string haystack;
+        for (size_t i = 0; i < length; ++i) {
+            haystack += static_cast<char>('a' + (i * 7) % 5);
+        }
+        for (std::string_view needle : {"a", "ab", "cab", "ecbda", "eb", "zz", "bdacebdac"}) {
+            ASSERT_EQ(text::find(haystack, needle), std::string_view(haystack).find(needle));
+        }
+        size_t newlines = 0;
+        std::string lines = haystack;
+        for (size_t i = 0; i < lines.size(); i += 3) {
+            lines[i] = '\n';
+            newlines++;
+        }
+        ASSERT_EQ(text::count_byte(lines, '\n'), newlines);
+        
+        std::string upper = haystack;
+        for (char& c : upper) c = static_cast<char>(c - 'a' + 'A');
+        ASSERT_TRUE(text::equals_ignore_case(haystack, upper));
+        if (length > 0) {
+            upper[length - 1] = '@';  // '@' + 0x20 is '`', not a letter
+            ASSERT_FALSE(text::equals_ignore_case(haystack, upper));
+        }
+    }
+    ASSERT_EQ(text::count_lines(""), 0);
+    ASSERT_EQ(text::count_lines("a\nb"), 2);
+    ASSERT_EQ(text::count_lines("a\nb\n"), 2);
+    ASSERT_FALSE(text::equals_ignore_case("\xC3\xA9", "\xC3\x89"));
+    
+    std::string ascii(40, 'x');
+    ASSERT_TRUE(text::is_valid_utf8(ascii + "\xE2\x82\xAC" + ascii + "\xF4\x8F\xBF\xBF"));
+    ASSERT_FALSE(text::is_valid_utf8(ascii + "\xE2\x82"));            // Truncated
+    ASSERT_FALSE(text::is_valid_utf8(ascii + "\xE0\x80\xAF" + ascii)); // Overlong
+    ASSERT_FALSE(text::is_valid_utf8("\xED\xA0\x80"));                 // Surrogate
+    ASSERT_FALSE(text::is_valid_utf8("\xF4\x90\x80\x80"));             // Past U+10FFFF
+    ASSERT_FALSE(text::is_valid_utf8(ascii + "\x80"));                 // Stray continuation
+    
+    std::string_view record = "GET /index.html 200";
+    ASSERT_EQ(text::split_field(record, " ", 1).value(), "/index.html");
+    ASSERT_EQ(text::split_field(record, " ", 1)->data(), record.data() + 4);
+    ASSERT_EQ(text::split_field("a,,b", ",", 1).value(), "");
+    ASSERT_FALSE(text::split_field(record, " ", 3).has_value());
+    ASSERT_FALSE(text::split_field(record, "", 0).has_value());
+}
+
+TEST(string_builtins) {
+    auto run = [](const std::string& expression) {
+        Parser parser(Lexer("package main; fn main() i32 { return " + expression + "; }").tokenize_all());
+        auto program = parser.parse();
+        Chunk chunk;
+        Compiler compiler;
+        CompileResult compile_result = compiler.compile(*program, chunk);
+        assert(compile_result == CompileResult::OK);
+        VM vm;
+        if (vm.run(chunk) != VMResult::OK) {
+            return "error: " + vm.get_error_message();
+        }
+        return vm.peek_stack_top().to_string();
+    };
+    std::string result = run("find(\"key=value\", \"=\")");
+    ASSERT_EQ(result, "3");
+    result = run("find(\"key=value\", \"==\")");
+    ASSERT_EQ(result, "-1");
+    result = run("split(\"GET /a 200\", \" \", 2)");
+    ASSERT_EQ(result, "200");
+    result = run("split(\"GET /a 200\", \" \", 3)");
+    ASSERT_EQ(result, "nil");
+    result = run("equals_ignore_case(\"Content-Type\", \"content-type\")");
+    ASSERT_EQ(result, "true");
+    result = run("is_utf8(\"caf\xC3\xA9\")");
+    ASSERT_EQ(result, "true");
+    result = run("count_lines(\"a\\nb\\nc\")");
+    ASSERT_EQ(result, "3");
+    result = run("find(1, \"x\")");
+    ASSERT_EQ(result, "error: find requires string arguments");
+    result = run("split(\"a b\", \" \", 0 - 1)");
+    ASSERT_EQ(result, "error: split requires a non-negative integer index");
+    
+    // A field outlives the stack slot of the string it was split from
+    result = run("split(\"x\" + \",y,z\", \",\", 2)");
+    ASSERT_EQ(result, "z");
+    StringRef parent = StringRef::make("left right");
+    StringRef field(StringObject::make_slice(parent.get(), parent.view().substr(5)));
+    ASSERT_EQ(parent.get()->ref_count(), 2);
+    parent = StringRef();
+    ASSERT_EQ(field.view(), "right");
+}
+
 int main() {
     std::cout << "Running VM Tests..." << std::endl;
     
@@ -559,6 +1736,8 @@ int main() {
     RUN_TEST(vm_comparison_equal);
     RUN_TEST(vm_comparison_less_than);
     RUN_TEST(vm_division_by_zero);
+    RUN_TEST(vm_integer_overflow_wraps);
+    RUN_TEST(vm_operators_replace_operands_in_place);
     
     // Integration test
     RUN_TEST(vm_basic_function_return);
@@ -573,6 +1752,66 @@ int main() {
     RUN_TEST(end_to_end_arithmetic_expression);
     RUN_TEST(end_to_end_comparison_expression);
     
+    // Profile tests
+    RUN_TEST(profile_collection);
+    RUN_TEST(profile_round_trip);
+    RUN_TEST(compiler_profile_guided_superinstructions);
+    
+    // Symbolization tests
+    RUN_TEST(chunk_line_table);
+    RUN_TEST(compiler_records_lines_and_name);
+    RUN_TEST(perf_map_writer);
+    RUN_TEST(perf_map_shared_across_threads);
+    
+    // Metrics tests
+    RUN_TEST(metrics_pipeline);
+    RUN_TEST(metrics_runtime_errors_and_export);
+    RUN_TEST(metrics_histogram_shards_sum_on_read);
+    
+    // REPL tests
+    RUN_TEST(repl_expressions);
+    RUN_TEST(repl_errors_keep_session_alive);
+    RUN_TEST(repl_string_results);
+    
+    // Allocation tracking tests
+    RUN_TEST(allocation_scopes_are_per_thread);
+    RUN_TEST(allocation_scope_nesting);
+    
+    // Memory resource tests
+    RUN_TEST(memory_resource_containers);
+    RUN_TEST(memory_resource_monotonic_request);
+    
+    // Object pool tests
+    RUN_TEST(object_pool_reuse);
+    RUN_TEST(object_pool_steady_state_requests);
+    
+    // Reference counting tests
+    
+    // Snippet tests
+    RUN_TEST(snippet_matches_runtime_pipeline);
+    
+    // Chunk builder tests
+    RUN_TEST(chunk_builder_folds_constants);
+    RUN_TEST(chunk_builder_keeps_runtime_errors);
+    RUN_TEST(chunk_builder_rejects_constant_overflow);
+    
+    // Column binding tests
+    RUN_TEST(column_binding_reads_host_memory);
+    RUN_TEST(column_binding_scope);
+    
+    // String and I/O builtin tests
+    RUN_TEST(string_values);
+    RUN_TEST(string_results_outlive_chunk_and_vm);
+    RUN_TEST(shared_chunk_runs_on_several_threads);
+    RUN_TEST(string_concatenation_appends_in_place);
+    RUN_TEST(print_and_read_line_builtins);
+    RUN_TEST(output_buffer_batches_writes);
+    RUN_TEST(line_reader_grows_for_long_lines);
+    
+    // String builtin tests
+    RUN_TEST(string_kernels_match_scalar_results);
+    RUN_TEST(string_builtins);
+    
     std::cout << "All tests passed!" << std::endl;
     return 0;
 }
\ No newline at end of file
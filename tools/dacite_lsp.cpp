@@ -0,0 +1,55 @@
+#include <iostream>
+#include <string>
+#include "../src/language_server.h"
+
+// Language server over stdio using LSP base protocol framing:
+//   Content-Length: <bytes>\r\n\r\n<JSON-RPC message>
+
+namespace {
+
+/// Read one framed message from stdin, returns false at end of input
+bool read_message(std::string& body) {
+    size_t content_length = 0;
+    bool has_length = false;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            if (!has_length) continue;
+            body.resize(content_length);
+            return static_cast<bool>(std::cin.read(body.data(), static_cast<std::streamsize>(content_length)));
+        }
+        constexpr std::string_view header = "Content-Length:";
+        if (line.compare(0, header.size(), header) == 0) {
+            try {
+                content_length = std::stoul(line.substr(header.size()));
+                has_length = true;
+            } catch (const std::exception&) {
+                has_length = false;
+            }
+        }
+    }
+    return false;
+}
+
+void write_message(const std::string& body) {
+    std::cout << "Content-Length: " << body.size() << "\r\n\r\n" << body;
+    std::cout.flush();
+}
+
+} // namespace
+
+int main() {
+    std::ios::sync_with_stdio(false);
+    dacite::LanguageServer server;
+    std::string body;
+
+    while (!server.should_exit() && read_message(body)) {
+        for (const auto& response : server.handle(body)) {
+            write_message(response);
+        }
+    }
+    return server.exit_code();
+}
\ No newline at end of file
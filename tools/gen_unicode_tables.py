@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Regenerate the XID_Start/XID_Continue tables in src/unicode.cpp.
+
+Uses the Unicode database bundled with Python, so the tables follow the running
+Python's Unicode version. Prints the table definitions to stdout.
+
+Each entry packs a range of code points as (first << 11) | (count - 1); ranges
+longer than 2048 code points are split across entries.
+"""
+
+import unicodedata
+
+RANGE_BITS = 11
+MAX_COUNT = 1 << RANGE_BITS
+
+
+def ranges(predicate):
+    result = []
+    start = None
+    for code_point in range(0x80, 0x110000):
+        if predicate(code_point):
+            if start is None:
+                start = code_point
+        elif start is not None:
+            result.append((start, code_point - 1))
+            start = None
+    if start is not None:
+        result.append((start, 0x10FFFF))
+    return result
+
+
+def packed(pairs):
+    entries = []
+    for first, last in pairs:
+        while first <= last:
+            count = min(last - first + 1, MAX_COUNT)
+            entries.append((first << RANGE_BITS) | (count - 1))
+            first += count
+    return entries
+
+
+def emit(name, entries):
+    print(f"constexpr uint32_t {name}[] = {{")
+    for i in range(0, len(entries), 6):
+        print("    " + ", ".join(f"0x{entry:08X}" for entry in entries[i:i + 6]) + ",")
+    print("};")
+
+
+def main():
+    print(f"// Unicode {unicodedata.unidata_version}, generated by tools/gen_unicode_tables.py")
+    # Python identifiers are defined by XID_Start and XID_Continue
+    emit("XID_START", packed(ranges(lambda c: chr(c).isidentifier())))
+    print()
+    emit("XID_CONTINUE", packed(ranges(lambda c: ("a" + chr(c)).isidentifier())))
+
+
+if __name__ == "__main__":
+    main()
\ No newline at end of file